@@ -0,0 +1,153 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2026 Chistyakov Alexander.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef _LIBS_SIGNALS_CHILD_REAPER_H_
+#define _LIBS_SIGNALS_CHILD_REAPER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <sys/resource.h>
+#include <sys/types.h>
+
+#include "signals/manager.h"
+
+namespace wstux {
+namespace signals {
+
+/// \brief  Exit of a child process.
+struct child_exit
+{
+    ::pid_t pid;
+    /// \brief  Status in the 'waitpid' format, see 'WIFEXITED' and others.
+    int status;
+    /// \brief  Resources used by the child.
+    ::rusage usage;
+};
+
+/// \brief  Callback of the child exit.
+using child_exit_fn_t = std::function<void(const child_exit&)>;
+
+/**
+ *  \brief  Reaper of the child processes.
+ *
+ *  The reaper sets the coalesced 'SIGCHLD' handler of the manager, so it is
+ *  called once per wakeup of the processing thread no matter how many
+ *  children have exited. The handler reaps the exited children by
+ *  'wait4(-1, WNOHANG)' calls, one per exit, and calls the callbacks
+ *  registered for their pids, so the cost of the wakeup depends on the number
+ *  of exits and not on the number of watched children.
+ *
+ *  The reaper reaps every child of the process. Exits of the children that
+ *  are not watched are passed to the default callback, or kept until the pid
+ *  is watched if there is no default callback, so a child exiting before
+ *  'watch' is called is not lost. A kept exit is passed to 'watch' only if no
+ *  child with the pid exists, otherwise the pid has been recycled by a new
+ *  child and the exit of its predecessor is discarded. When 'max_unclaimed'
+ *  exits are kept, the oldest one is dropped for a new one.
+ *
+ *  The reaper must be destroyed while the manager does not process signals.
+ */
+class child_reaper final
+{
+public:
+    /// \brief  Maximum number of the kept exits of unwatched children.
+    static constexpr std::size_t max_unclaimed = 4096;
+
+public:
+    explicit child_reaper(manager& sm);
+
+    child_reaper(const child_reaper&) = delete;
+    child_reaper& operator=(const child_reaper&) = delete;
+
+    ~child_reaper();
+
+    /// \brief  Returns the number of the kept exits dropped because of the
+    ///         'max_unclaimed' limit.
+    std::uint64_t dropped() const;
+
+    /// \brief  Returns true if the 'SIGCHLD' handler has been installed.
+    bool is_installed() const { return m_is_installed; }
+
+    /// \brief  Sets the callback of the exits of unwatched children.
+    void set_default_callback(child_exit_fn_t func);
+
+    /// \brief  Stops watching the child, its exit is passed to the default
+    ///         callback.
+    /// \return True - the child has been watched.
+    bool unwatch(::pid_t pid);
+
+    /// \brief  Registers the callback of the child exit. If the child has
+    ///         already been reaped, the callback is called immediately by the
+    ///         calling thread.
+    /// \param  pid - child process id.
+    /// \param  func - callback called once by the processing thread.
+    /// \return True - the callback has been registered. False - the pid is
+    ///     invalid, already watched or is not a child of the process and has
+    ///     no kept exit.
+    bool watch(::pid_t pid, child_exit_fn_t func);
+
+    /// \brief  Returns the number of the watched children.
+    std::size_t watched() const;
+
+private:
+    struct unclaimed_exit
+    {
+        child_exit child;
+        /// \brief  Position in the order of the kept exits.
+        std::list<::pid_t>::iterator order_it;
+    };
+
+private:
+    void keep(const child_exit& child);
+
+    void reap();
+
+private:
+    manager& m_manager;
+    bool m_is_installed;
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<::pid_t, child_exit_fn_t> m_callbacks;
+    std::unordered_map<::pid_t, unclaimed_exit> m_unclaimed;
+    /// \brief  Pids of the kept exits from the oldest to the newest.
+    std::list<::pid_t> m_unclaimed_order;
+    std::uint64_t m_dropped;
+    child_exit_fn_t m_default;
+
+    /// \brief  Buffers of the processing thread reused between wakeups.
+    std::vector<child_exit> m_exits;
+    std::vector<std::pair<child_exit_fn_t, child_exit>> m_calls;
+};
+
+} // namespace signals
+} // namespace wstux
+
+#endif /* _LIBS_SIGNALS_CHILD_REAPER_H_ */
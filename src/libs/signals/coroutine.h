@@ -0,0 +1,286 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2026 Chistyakov Alexander.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef _LIBS_SIGNALS_COROUTINE_H_
+#define _LIBS_SIGNALS_COROUTINE_H_
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "signals/manager.h"
+
+namespace wstux {
+namespace signals {
+
+/**
+ *  \brief  Awaitable signals for C++20 coroutines.
+ *
+ *  The object sets handlers of the signals on the manager. A coroutine
+ *  awaiting 'next(sig)' is resumed with the next record of the signal by the
+ *  thread dispatching signals: the processing loop, 'dispatch_pending' or
+ *  'poll_once'. Awaiters are linked into the signal's waiting list inside
+ *  their coroutine frames, so awaiting a signal does not allocate.
+ *
+ *  Each signal has a channel: a ring of records and a list of waiters. Records
+ *  received while no coroutine is waiting, e.g. between two awaits of a
+ *  stream, are buffered in the ring up to the capacity and the rest are
+ *  counted as dropped. The buffered records are returned by the following
+ *  awaits in the order they have been received, without suspending. Waiters
+ *  are resumed in the order they have started waiting, one record per waiter.
+ *
+ *  The object must be destroyed while the manager does not process signals,
+ *  the coroutines still waiting are not resumed.
+ */
+class async_signals final
+{
+    struct channel;
+
+public:
+    /// \brief  Awaiter of the next record of a signal.
+    class awaiter final
+    {
+    public:
+        awaiter(async_signals& owner, sig_num_t sig) : m_owner(owner), m_sig(sig) {}
+
+        bool await_ready() { return m_owner.try_pop(m_sig, m_info); }
+
+        bool await_suspend(std::coroutine_handle<> handle)
+        {
+            m_handle = handle;
+            return m_owner.suspend(m_sig, *this);
+        }
+
+        sig_info_t await_resume() const { return m_info; }
+
+    private:
+        friend class async_signals;
+
+        async_signals& m_owner;
+        sig_num_t m_sig;
+        sig_info_t m_info = {};
+        std::coroutine_handle<> m_handle;
+        awaiter* m_p_next = nullptr;
+    };
+
+    /**
+     *  \brief  Endless asynchronous sequence of the records of a signal.
+     *
+     *  The stream reads the channel of the signal, so the records received
+     *  while the consumer is busy between two awaits are not lost but wait in
+     *  the channel. Streams and 'next' calls of the same signal share the
+     *  channel, each record is returned once.
+     */
+    class stream final
+    {
+    public:
+        stream(async_signals& owner, sig_num_t sig) : m_owner(owner), m_sig(sig) {}
+
+        /// \brief  Returns the number of records waiting in the channel.
+        std::size_t buffered() const { return m_owner.buffered(m_sig); }
+
+        awaiter next() { return awaiter(m_owner, m_sig); }
+
+        sig_num_t signal() const { return m_sig; }
+
+    private:
+        async_signals& m_owner;
+        sig_num_t m_sig;
+    };
+
+public:
+    /// \brief  Sets the handlers of the signals.
+    /// \param  sm - signal manager.
+    /// \param  signals - awaited signals.
+    /// \param  capacity - maximum number of buffered records per signal.
+    async_signals(manager& sm, std::initializer_list<sig_num_t> signals, std::size_t capacity = 64)
+        : m_manager(sm)
+    {
+        for (sig_num_t sig : signals) {
+            if ((sig <= 0) || (sig >= _NSIG) || m_channels[sig]) {
+                m_is_installed = false;
+                continue;
+            }
+            m_channels[sig] = std::make_unique<channel>(capacity);
+            const bool is_set = m_manager.set_handler(sig, [this](sig_num_t signo, const sig_info_t& info) -> void {
+                push(signo, info);
+            });
+            if (! is_set) {
+                m_channels[sig].reset();
+                m_is_installed = false;
+            }
+        }
+    }
+
+    async_signals(const async_signals&) = delete;
+    async_signals& operator=(const async_signals&) = delete;
+
+    ~async_signals()
+    {
+        for (sig_num_t sig = 1; sig < _NSIG; ++sig) {
+            if (m_channels[sig]) {
+                m_manager.remove_handler(sig);
+            }
+        }
+    }
+
+    /// \brief  Returns the number of records received while no coroutine has
+    ///         been waiting and not taken yet.
+    std::size_t buffered(sig_num_t sig) const
+    {
+        channel* p_channel = find(sig);
+        if (p_channel == nullptr) {
+            return 0;
+        }
+        std::lock_guard<std::mutex> lock(p_channel->mutex);
+        return p_channel->size;
+    }
+
+    /// \brief  Returns the number of records lost because of the buffer
+    ///         overflow.
+    std::uint64_t dropped(sig_num_t sig) const
+    {
+        channel* p_channel = find(sig);
+        if (p_channel == nullptr) {
+            return 0;
+        }
+        std::lock_guard<std::mutex> lock(p_channel->mutex);
+        return p_channel->dropped;
+    }
+
+    /// \brief  Returns true if the handlers of all signals have been set.
+    bool is_installed() const { return m_is_installed; }
+
+    /// \brief  Returns the awaiter of the next record of the signal. Awaiting
+    ///         a signal that is not handled by the object never resumes.
+    awaiter next(sig_num_t sig) { return awaiter(*this, sig); }
+
+    /// \brief  Returns the asynchronous sequence of the signal records.
+    stream records(sig_num_t sig) { return stream(*this, sig); }
+
+private:
+    struct channel
+    {
+        explicit channel(std::size_t capacity) : records(capacity) {}
+
+        std::mutex mutex;
+        std::vector<sig_info_t> records;
+        std::size_t first = 0;
+        std::size_t size = 0;
+        std::uint64_t dropped = 0;
+        awaiter* p_first = nullptr;
+        awaiter* p_last = nullptr;
+    };
+
+private:
+    channel* find(sig_num_t sig) const
+    {
+        return ((sig > 0) && (sig < _NSIG)) ? m_channels[sig].get() : nullptr;
+    }
+
+    void push(sig_num_t sig, const sig_info_t& info)
+    {
+        channel& ch = *m_channels[sig];
+        std::unique_lock<std::mutex> lock(ch.mutex);
+        awaiter* p_awaiter = ch.p_first;
+        if (p_awaiter == nullptr) {
+            if (ch.size < ch.records.size()) {
+                ch.records[(ch.first + ch.size) % ch.records.size()] = info;
+                ++ch.size;
+            } else {
+                ++ch.dropped;
+            }
+            return;
+        }
+
+        ch.p_first = p_awaiter->m_p_next;
+        if (ch.p_first == nullptr) {
+            ch.p_last = nullptr;
+        }
+        lock.unlock();
+        // The coroutine is resumed by the dispatching thread.
+        p_awaiter->m_info = info;
+        p_awaiter->m_handle.resume();
+    }
+
+    bool suspend(sig_num_t sig, awaiter& waiter)
+    {
+        channel* p_channel = find(sig);
+        if (p_channel == nullptr) {
+            return true;
+        }
+
+        std::lock_guard<std::mutex> lock(p_channel->mutex);
+        if (pop(*p_channel, waiter.m_info)) {
+            return false;
+        }
+        waiter.m_p_next = nullptr;
+        if (p_channel->p_last != nullptr) {
+            p_channel->p_last->m_p_next = &waiter;
+        } else {
+            p_channel->p_first = &waiter;
+        }
+        p_channel->p_last = &waiter;
+        return true;
+    }
+
+    bool try_pop(sig_num_t sig, sig_info_t& info)
+    {
+        channel* p_channel = find(sig);
+        if (p_channel == nullptr) {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(p_channel->mutex);
+        return pop(*p_channel, info);
+    }
+
+    static bool pop(channel& ch, sig_info_t& info)
+    {
+        if (ch.size == 0) {
+            return false;
+        }
+        info = ch.records[ch.first];
+        ch.first = (ch.first + 1) % ch.records.size();
+        --ch.size;
+        return true;
+    }
+
+private:
+    manager& m_manager;
+    bool m_is_installed = true;
+    std::unique_ptr<channel> m_channels[_NSIG];
+};
+
+} // namespace signals
+} // namespace wstux
+
+#endif /* __cpp_impl_coroutine */
+
+#endif /* _LIBS_SIGNALS_COROUTINE_H_ */
@@ -0,0 +1,172 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2026 Chistyakov Alexander.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+extern "C" {
+    #include <sys/wait.h>
+    #include <unistd.h>
+}
+
+#include <csignal>
+#include <iterator>
+
+#include "signals/child_reaper.h"
+
+namespace wstux {
+namespace signals {
+namespace {
+
+/// \brief  Returns true if the process has a child with the pid, running or
+///         exited but not reaped yet.
+bool has_child(::pid_t pid)
+{
+    ::siginfo_t info;
+    return (::waitid(P_PID, static_cast<::id_t>(pid), &info, WEXITED | WNOHANG | WNOWAIT) == 0);
+}
+
+} // <anonymous> namespace
+
+child_reaper::child_reaper(manager& sm)
+    : m_manager(sm)
+    , m_is_installed(false)
+    , m_dropped(0)
+{
+    m_is_installed = m_manager.set_handler(SIGCHLD, [this](sig_num_t, std::size_t) -> void { reap(); });
+    if (m_is_installed) {
+        // Children exited before the handler has been set are reaped by the
+        // first wakeup.
+        ::kill(::getpid(), SIGCHLD);
+    }
+}
+
+child_reaper::~child_reaper()
+{
+    if (m_is_installed) {
+        m_manager.remove_handler(SIGCHLD);
+    }
+}
+
+std::uint64_t child_reaper::dropped() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_dropped;
+}
+
+void child_reaper::keep(const child_exit& child)
+{
+    auto it = m_unclaimed.find(child.pid);
+    if (it != m_unclaimed.end()) {
+        // The pid has been recycled, the exit of the predecessor is stale.
+        m_unclaimed_order.erase(it->second.order_it);
+        m_unclaimed.erase(it);
+    } else if (m_unclaimed.size() >= max_unclaimed) {
+        m_unclaimed.erase(m_unclaimed_order.front());
+        m_unclaimed_order.pop_front();
+        ++m_dropped;
+    }
+    m_unclaimed_order.push_back(child.pid);
+    m_unclaimed.emplace(child.pid, unclaimed_exit{child, std::prev(m_unclaimed_order.end())});
+}
+
+void child_reaper::reap()
+{
+    // Children are reaped and their callbacks are taken under a single lock,
+    // so 'watch' sees a stable set of children. The callbacks are called
+    // without the lock, so they can watch new children.
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        child_exit child;
+        while ((child.pid = ::wait4(-1, &child.status, WNOHANG, &child.usage)) > 0) {
+            m_exits.push_back(child);
+        }
+        for (const child_exit& e : m_exits) {
+            auto it = m_callbacks.find(e.pid);
+            if (it != m_callbacks.end()) {
+                m_calls.emplace_back(std::move(it->second), e);
+                m_callbacks.erase(it);
+            } else if (m_default) {
+                m_calls.emplace_back(m_default, e);
+            } else {
+                keep(e);
+            }
+        }
+    }
+    m_exits.clear();
+
+    for (std::pair<child_exit_fn_t, child_exit>& call : m_calls) {
+        call.first(call.second);
+    }
+    m_calls.clear();
+}
+
+void child_reaper::set_default_callback(child_exit_fn_t func)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_default = std::move(func);
+}
+
+bool child_reaper::unwatch(::pid_t pid)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return (m_callbacks.erase(pid) != 0);
+}
+
+bool child_reaper::watch(::pid_t pid, child_exit_fn_t func)
+{
+    if ((pid <= 0) || ! func) {
+        return false;
+    }
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_callbacks.count(pid) != 0) {
+        return false;
+    }
+    auto it = m_unclaimed.find(pid);
+    const bool is_child = has_child(pid);
+    if ((it != m_unclaimed.end()) && ! is_child) {
+        const child_exit child = it->second.child;
+        m_unclaimed_order.erase(it->second.order_it);
+        m_unclaimed.erase(it);
+        lock.unlock();
+        func(child);
+        return true;
+    }
+    if (it != m_unclaimed.end()) {
+        // A child with the pid exists, so the kept exit is of its predecessor.
+        m_unclaimed_order.erase(it->second.order_it);
+        m_unclaimed.erase(it);
+    } else if (! is_child) {
+        return false;
+    }
+    m_callbacks.emplace(pid, std::move(func));
+    return true;
+}
+
+std::size_t child_reaper::watched() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_callbacks.size();
+}
+
+} // namespace signals
+} // namespace wstux
@@ -0,0 +1,100 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2026 Chistyakov Alexander.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef _LIBS_SIGNALS_EPOLL_FD_H_
+#define _LIBS_SIGNALS_EPOLL_FD_H_
+
+#ifdef __linux__
+    #include <sys/epoll.h>
+    #include <unistd.h>
+#else
+    #error "Unsupported platform for using epoll fd"
+#endif
+
+namespace wstux {
+namespace signals {
+namespace details {
+
+/**
+ *  \brief  Epoll file descriptor.
+ *
+ *  The descriptor becomes readable when one of the added descriptors is
+ *  readable, so several descriptors can be exposed to an external reactor as
+ *  a single one.
+ */
+class epoll_fd final
+{
+public:
+    epoll_fd() = default;
+
+    ~epoll_fd() { close(); }
+
+    /// \brief  Adds the descriptor to be watched for readability.
+    /// \param  fd - watched descriptor.
+    /// \return True - the descriptor has been added successfully.
+    inline bool add(int fd)
+    {
+        ::epoll_event event = {};
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        return (::epoll_ctl(m_fd, EPOLL_CTL_ADD, fd, &event) == 0);
+    }
+
+    /// \brief  Closes the epoll file descriptor.
+    inline void close()
+    {
+        if (m_fd >= 0) {
+            ::close(m_fd);
+            m_fd = -1;
+        }
+    }
+
+    /// \brief  Returns the file descriptor that becomes readable when one of
+    ///         the watched descriptors is readable.
+    inline int fd() const { return m_fd; }
+
+    inline bool is_open() const { return (m_fd >= 0); }
+
+    /// \brief  Creates the epoll file descriptor.
+    /// \return True - the descriptor has been created successfully.
+    inline bool open()
+    {
+        close();
+        m_fd = ::epoll_create1(EPOLL_CLOEXEC);
+        return (m_fd >= 0);
+    }
+
+private:
+    epoll_fd(const epoll_fd&);
+    epoll_fd& operator=(const epoll_fd&);
+
+private:
+    int m_fd = -1;
+};
+
+} // namespace details
+} // namespace signals
+} // namespace wstux
+
+#endif /* _LIBS_SIGNALS_EPOLL_FD_H_ */
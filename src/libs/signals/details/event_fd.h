@@ -0,0 +1,93 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2026 Chistyakov Alexander.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef _LIBS_SIGNALS_EVENT_FD_H_
+#define _LIBS_SIGNALS_EVENT_FD_H_
+
+#ifdef __linux__
+    #include <sys/eventfd.h>
+    #include <unistd.h>
+#else
+    #error "Unsupported platform for using event fd"
+#endif
+
+#include <cerrno>
+#include <cstdint>
+
+namespace wstux {
+namespace signals {
+namespace details {
+
+class event_fd final
+{
+public:
+    /// \brief  Creates a non-blocking event file descriptor with zero count.
+    event_fd()
+        : m_fd(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+    {}
+
+    /// \brief  Closes the event file descriptor.
+    ~event_fd()
+    {
+        if (m_fd >= 0) {
+            ::close(m_fd);
+        }
+    }
+
+    /// \brief  Returns the file descriptor that becomes readable after post.
+    inline int fd() const { return m_fd; }
+
+    /// \brief  Increments the event counter and wakes up the waiter.
+    /// \note   The function is async-signal-safe.
+    inline void post()
+    {
+        const std::uint64_t value = 1;
+        const int saved_errno = errno;
+        while ((::write(m_fd, &value, sizeof(value)) < 0) && (errno == EINTR)) {}
+        errno = saved_errno;
+    }
+
+    /// \brief  Resets the event counter.
+    /// \return True if the event has been posted since the last reset.
+    inline bool reset()
+    {
+        std::uint64_t value = 0;
+        ssize_t rc;
+        while (((rc = ::read(m_fd, &value, sizeof(value))) < 0) && (errno == EINTR)) {}
+        return (rc == sizeof(value));
+    }
+
+private:
+    event_fd(const event_fd&);
+    event_fd& operator=(const event_fd&);
+
+private:
+    int m_fd;
+};
+
+} // namespace details
+} // namespace signals
+} // namespace wstux
+
+#endif /* _LIBS_SIGNALS_EVENT_FD_H_ */
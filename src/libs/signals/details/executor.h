@@ -0,0 +1,192 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2026 Chistyakov Alexander.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef _LIBS_SIGNALS_EXECUTOR_H_
+#define _LIBS_SIGNALS_EXECUTOR_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace wstux {
+namespace signals {
+namespace details {
+
+/**
+ *  \brief  Pool of worker threads executing tasks grouped into strands.
+ *
+ *  Tasks submitted with the same key form a strand: they are executed one
+ *  after another in the order of submission, while tasks of different strands
+ *  are executed in parallel. A strand that has pending tasks is placed in the
+ *  ready queue of its priority level, workers take strands of the highest
+ *  level first and execute one task of the strand at a time, so a strand of
+ *  a higher level overtakes the bulk work of the lower ones.
+ */
+template<typename TTask, std::size_t TLevels>
+class executor final
+{
+public:
+    executor() = default;
+
+    ~executor() { stop(); }
+
+    bool is_running() const { return ! m_workers.empty(); }
+
+    /// \brief  Starts the workers.
+    /// \param  workers - number of worker threads.
+    /// \param  keys - number of strands, the keys are in range [0, keys).
+    void start(std::size_t workers, std::size_t keys)
+    {
+        stop();
+
+        m_is_stop = false;
+        m_strands.clear();
+        m_strands.resize(keys);
+        for (std::size_t i = 0; i < workers; ++i) {
+            m_workers.emplace_back(&executor::run, this);
+        }
+    }
+
+    /// \brief  Executes the pending tasks and stops the workers.
+    void stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_is_stop = true;
+        }
+        m_cv.notify_all();
+        for (std::thread& worker : m_workers) {
+            worker.join();
+        }
+        m_workers.clear();
+    }
+
+    /// \brief  Submits the task to the strand.
+    /// \param  key - strand key.
+    /// \param  level - priority level of the strand, in range [0, TLevels).
+    /// \param  task - task to be executed.
+    void submit(std::size_t key, std::size_t level, TTask&& task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            strand& s = m_strands[key];
+            s.tasks.push_back(std::move(task));
+            s.level = level;
+            if (s.is_scheduled) {
+                return;
+            }
+            s.is_scheduled = true;
+            m_ready[level].push_back(key);
+            ++m_ready_count;
+        }
+        m_cv.notify_one();
+    }
+
+    /// \brief  Waits until all submitted tasks are executed.
+    void wait_idle()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_idle_cv.wait(lock, [this]() -> bool { return (m_ready_count == 0) && (m_active_count == 0); });
+    }
+
+private:
+    struct strand
+    {
+        std::deque<TTask> tasks;
+        std::size_t level = 0;
+        bool is_scheduled = false;
+    };
+
+private:
+    executor(const executor&);
+    executor& operator=(const executor&);
+
+    std::size_t pop_ready()
+    {
+        for (std::size_t level = TLevels; level-- > 0;) {
+            if (! m_ready[level].empty()) {
+                const std::size_t key = m_ready[level].front();
+                m_ready[level].pop_front();
+                --m_ready_count;
+                return key;
+            }
+        }
+        return 0;
+    }
+
+    void run()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true) {
+            m_cv.wait(lock, [this]() -> bool { return m_is_stop || (m_ready_count != 0); });
+            if (m_ready_count == 0) {
+                return;
+            }
+
+            const std::size_t key = pop_ready();
+            strand& s = m_strands[key];
+            TTask task = std::move(s.tasks.front());
+            s.tasks.pop_front();
+            ++m_active_count;
+
+            lock.unlock();
+            task();
+            lock.lock();
+
+            --m_active_count;
+            if (s.tasks.empty()) {
+                s.is_scheduled = false;
+            } else {
+                m_ready[s.level].push_back(key);
+                ++m_ready_count;
+                m_cv.notify_one();
+            }
+            if ((m_ready_count == 0) && (m_active_count == 0)) {
+                m_idle_cv.notify_all();
+            }
+        }
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::condition_variable m_idle_cv;
+    bool m_is_stop = false;
+
+    std::vector<strand> m_strands;
+    std::deque<std::size_t> m_ready[TLevels];
+    std::size_t m_ready_count = 0;
+    std::size_t m_active_count = 0;
+    std::vector<std::thread> m_workers;
+};
+
+} // namespace details
+} // namespace signals
+} // namespace wstux
+
+#endif /* _LIBS_SIGNALS_EXECUTOR_H_ */
@@ -0,0 +1,184 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2026 Chistyakov Alexander.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef _LIBS_SIGNALS_FUNCTION_H_
+#define _LIBS_SIGNALS_FUNCTION_H_
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace wstux {
+namespace signals {
+namespace details {
+
+template<typename TSignature, std::size_t TSize>
+class function;
+
+/**
+ *  \brief  Move-only callable wrapper with inline storage.
+ *
+ *  Callables that fit into TSize bytes and are nothrow move constructible are
+ *  stored inside the wrapper. Other callables are allocated on the heap once,
+ *  when the wrapper is created, and moving the wrapper only moves the pointer.
+ *  In both cases calling the wrapper does not allocate and costs a single
+ *  indirect call.
+ */
+template<typename TRet, typename... TArgs, std::size_t TSize>
+class function<TRet(TArgs...), TSize> final
+{
+public:
+    function() = default;
+
+    function(std::nullptr_t) {}
+
+    template<typename TFunc,
+             typename TDecay = typename std::decay<TFunc>::type,
+             typename = typename std::enable_if<! std::is_same<TDecay, function>::value &&
+                                                std::is_invocable_r<TRet, TDecay&, TArgs...>::value>::type>
+    function(TFunc&& func)
+    {
+        if constexpr (is_inline<TDecay>::value) {
+            ::new (static_cast<void*>(&m_storage)) TDecay(std::forward<TFunc>(func));
+            m_p_invoke = &invoke<TDecay>;
+            m_p_manage = &manage<TDecay>;
+        } else {
+            ::new (static_cast<void*>(&m_storage)) TDecay*(new TDecay(std::forward<TFunc>(func)));
+            m_p_invoke = &invoke_heap<TDecay>;
+            m_p_manage = &manage_heap<TDecay>;
+        }
+    }
+
+    function(function&& other) noexcept { move_from(other); }
+
+    ~function() { reset(); }
+
+    function& operator=(function&& other) noexcept
+    {
+        if (this != &other) {
+            reset();
+            move_from(other);
+        }
+        return *this;
+    }
+
+    function& operator=(std::nullptr_t) noexcept
+    {
+        reset();
+        return *this;
+    }
+
+    explicit operator bool() const { return (m_p_invoke != nullptr); }
+
+    TRet operator()(TArgs... args) const
+    {
+        return m_p_invoke(const_cast<void*>(static_cast<const void*>(&m_storage)), std::forward<TArgs>(args)...);
+    }
+
+    void reset() noexcept
+    {
+        if (m_p_manage) {
+            m_p_manage(nullptr, &m_storage);
+            m_p_invoke = nullptr;
+            m_p_manage = nullptr;
+        }
+    }
+
+private:
+    template<typename TFunc>
+    struct is_inline
+        : std::integral_constant<bool, (sizeof(TFunc) <= TSize) &&
+                                       (alignof(TFunc) <= alignof(std::max_align_t)) &&
+                                       std::is_nothrow_move_constructible<TFunc>::value>
+    {};
+
+private:
+    function(const function&);
+    function& operator=(const function&);
+
+    template<typename TFunc>
+    static TRet invoke(void* p_storage, TArgs... args)
+    {
+        return (*static_cast<TFunc*>(p_storage))(std::forward<TArgs>(args)...);
+    }
+
+    template<typename TFunc>
+    static TRet invoke_heap(void* p_storage, TArgs... args)
+    {
+        return (**static_cast<TFunc**>(p_storage))(std::forward<TArgs>(args)...);
+    }
+
+    /// \brief  Moves the callable from 'p_src' to 'p_dst' and destroys the
+    ///         source. If 'p_dst' is nullptr, the source is only destroyed.
+    template<typename TFunc>
+    static void manage(void* p_dst, void* p_src) noexcept
+    {
+        TFunc* p_func = static_cast<TFunc*>(p_src);
+        if (p_dst) {
+            ::new (p_dst) TFunc(std::move(*p_func));
+        }
+        p_func->~TFunc();
+    }
+
+    /// \brief  Moves the pointer to the heap-allocated callable from 'p_src'
+    ///         to 'p_dst'. If 'p_dst' is nullptr, the callable is deleted.
+    template<typename TFunc>
+    static void manage_heap(void* p_dst, void* p_src) noexcept
+    {
+        TFunc* p_func = *static_cast<TFunc**>(p_src);
+        if (p_dst) {
+            ::new (p_dst) TFunc*(p_func);
+        } else {
+            delete p_func;
+        }
+    }
+
+    void move_from(function& other) noexcept
+    {
+        if (other.m_p_manage) {
+            other.m_p_manage(&m_storage, &other.m_storage);
+            m_p_invoke = other.m_p_invoke;
+            m_p_manage = other.m_p_manage;
+            other.m_p_invoke = nullptr;
+            other.m_p_manage = nullptr;
+        }
+    }
+
+private:
+    using invoke_fn_t = TRet (*)(void*, TArgs...);
+    using manage_fn_t = void (*)(void*, void*);
+    using storage_t = typename std::aligned_storage<TSize, alignof(std::max_align_t)>::type;
+
+private:
+    invoke_fn_t m_p_invoke = nullptr;
+    manage_fn_t m_p_manage = nullptr;
+    storage_t m_storage;
+};
+
+} // namespace details
+} // namespace signals
+} // namespace wstux
+
+#endif /* _LIBS_SIGNALS_FUNCTION_H_ */
@@ -0,0 +1,171 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2026 Chistyakov Alexander.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef _LIBS_SIGNALS_HISTOGRAM_H_
+#define _LIBS_SIGNALS_HISTOGRAM_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace wstux {
+namespace signals {
+namespace details {
+
+/**
+ *  \brief  Lock-free log-linear histogram.
+ *
+ *  Each power of two range is split into four linear sub-buckets, so the
+ *  relative error of a value is below 25%. Values above 2^40 are counted in
+ *  the last bucket.
+ *
+ *  The histogram has a single writer at a time, so recording a value costs a
+ *  few relaxed loads and stores without locked instructions, while the
+ *  histogram can be read by any thread at any time.
+ */
+class histogram final
+{
+public:
+    static constexpr std::size_t sub_bucket_bits = 2;
+    static constexpr std::size_t sub_buckets = std::size_t(1) << sub_bucket_bits;
+    static constexpr std::size_t max_exponent = 40;
+    static constexpr std::size_t bucket_count = (max_exponent - sub_bucket_bits + 2) * sub_buckets;
+
+    /// \brief  Histogram state copied at one moment.
+    struct snapshot
+    {
+        std::uint64_t count = 0;
+        std::uint64_t sum = 0;
+        std::uint64_t max = 0;
+        std::uint64_t buckets[bucket_count] = {};
+
+        double mean() const { return (count != 0) ? static_cast<double>(sum) / static_cast<double>(count) : 0.; }
+
+        /// \brief  Returns the upper bound of the bucket containing the value
+        ///         of the given rank.
+        /// \param  p - rank in range [0, 1], e.g. 0.99 for the 99th percentile.
+        std::uint64_t percentile(double p) const
+        {
+            if (count == 0) {
+                return 0;
+            }
+
+            const std::uint64_t rank = static_cast<std::uint64_t>(p * static_cast<double>(count - 1)) + 1;
+            std::uint64_t seen = 0;
+            for (std::size_t i = 0; i < bucket_count; ++i) {
+                seen += buckets[i];
+                if (seen >= rank) {
+                    const std::uint64_t bound = (i + 1 < bucket_count) ? lower_bound(i + 1) - 1 : max;
+                    return (bound < max) ? bound : max;
+                }
+            }
+            return max;
+        }
+    };
+
+public:
+    histogram() = default;
+
+    static constexpr std::size_t index(std::uint64_t value)
+    {
+        if (value < sub_buckets) {
+            return static_cast<std::size_t>(value);
+        }
+
+        const std::size_t exponent = 63 - static_cast<std::size_t>(__builtin_clzll(value));
+        if (exponent > max_exponent) {
+            return bucket_count - 1;
+        }
+        const std::size_t sub = static_cast<std::size_t>(value >> (exponent - sub_bucket_bits)) & (sub_buckets - 1);
+        return (exponent - sub_bucket_bits + 1) * sub_buckets + sub;
+    }
+
+    static constexpr std::uint64_t lower_bound(std::size_t i)
+    {
+        if (i < sub_buckets) {
+            return i;
+        }
+
+        const std::size_t exponent = i / sub_buckets + sub_bucket_bits - 1;
+        return (sub_buckets + i % sub_buckets) << (exponent - sub_bucket_bits);
+    }
+
+    /// \brief  Records the value.
+    /// \note   Calls must be serialized by the caller.
+    void record(std::uint64_t value)
+    {
+        increment(m_buckets[index(value)], 1);
+        increment(m_count, 1);
+        increment(m_sum, value);
+        if (value > m_max.load(std::memory_order_relaxed)) {
+            m_max.store(value, std::memory_order_relaxed);
+        }
+    }
+
+    void reset()
+    {
+        for (std::atomic<std::uint64_t>& bucket : m_buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        m_count.store(0, std::memory_order_relaxed);
+        m_sum.store(0, std::memory_order_relaxed);
+        m_max.store(0, std::memory_order_relaxed);
+    }
+
+    /// \brief  Copies the histogram state. The copy is not atomic as a whole,
+    ///         concurrently recorded values may be partially reflected.
+    snapshot get() const
+    {
+        snapshot result;
+        result.count = m_count.load(std::memory_order_relaxed);
+        result.sum = m_sum.load(std::memory_order_relaxed);
+        result.max = m_max.load(std::memory_order_relaxed);
+        for (std::size_t i = 0; i < bucket_count; ++i) {
+            result.buckets[i] = m_buckets[i].load(std::memory_order_relaxed);
+        }
+        return result;
+    }
+
+private:
+    histogram(const histogram&);
+    histogram& operator=(const histogram&);
+
+private:
+    static void increment(std::atomic<std::uint64_t>& counter, std::uint64_t value)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<std::uint64_t> m_buckets[bucket_count] = {};
+    std::atomic<std::uint64_t> m_count = {0};
+    std::atomic<std::uint64_t> m_sum = {0};
+    std::atomic<std::uint64_t> m_max = {0};
+};
+
+} // namespace details
+} // namespace signals
+} // namespace wstux
+
+#endif /* _LIBS_SIGNALS_HISTOGRAM_H_ */
@@ -22,173 +22,1070 @@
  * THE SOFTWARE.
  */
 
+#include <algorithm>
+#include <cerrno>
+#include <ctime>
+#include <future>
+
 #include "signals/manager.h"
 #include "signals/details/utils.h"
 
 namespace wstux {
 namespace signals {
+namespace {
+
+bool is_valid_limit(const rate_limit& limit)
+{
+    return (limit.policy == rate_policy::none)
+        || ((limit.interval.count() > 0) && (limit.leading || limit.trailing));
+}
+
+bool is_valid_signal(sig_num_t sig) { return (sig > 0) && (sig < _NSIG); }
+
+constexpr std::uint64_t sig_bit(sig_num_t sig) { return std::uint64_t(1) << (sig - 1); }
+
+manager::options make_options(backend b)
+{
+    manager::options opts;
+    opts.delivery = b;
+    return opts;
+}
+
+std::uint64_t now_ms() { return details::monotonic_ns() / 1000000; }
+
+sig_num_t signo(const sig_info_t& info) { return info.si_signo; }
+
+sig_num_t signo(const sig_record& record) { return record.signo; }
+
+sig_info_t to_info(const sig_record& record)
+{
+    sig_info_t info = {};
+    info.si_signo = record.signo;
+    info.si_code = record.code;
+    info.si_pid = record.pid;
+    info.si_uid = record.uid;
+    if (record.signo == SIGCHLD) {
+        info.si_status = record.status;
+    } else {
+        info.si_value = record.value;
+    }
+    return info;
+}
+
+::timespec to_timespec(const std::chrono::milliseconds& msec)
+{
+    ::timespec ts;
+    ts.tv_sec = msec.count() / 1000;
+    ts.tv_nsec = (msec.count() % 1000) * 1000000;
+    return ts;
+}
 
+} // <anonymous> namespace
+
+backend manager::m_backend = manager::default_backend;
+overflow_policy manager::m_overflow = overflow_policy::drop_newest;
 std::atomic_bool manager::m_is_stop = {false};
 details::semaphore manager::m_sem;
+details::event_fd manager::m_event;
+details::signal_fd manager::m_sig_fd;
+details::epoll_fd manager::m_notify_fd;
+details::timer_fd manager::m_notify_timer;
+std::uint64_t manager::m_armed_deadline = details::timer_wheel<_NSIG>::never;
+std::atomic<std::uint64_t> manager::m_next_deadline = {details::timer_wheel<_NSIG>::never};
+std::atomic_bool manager::m_is_attached = {false};
+std::atomic_bool manager::m_has_pending = {false};
+details::sig_set_t manager::m_attached_set;
+std::uint64_t manager::m_attached_generation = 0;
 std::unique_ptr<std::thread> manager::m_p_thread;
+manager::thread_options manager::m_thread_options;
+std::atomic_bool manager::m_is_waiting = {false};
+std::atomic<std::size_t> manager::m_wakes = {0};
+::pthread_t manager::m_wait_thread;
+sig_num_t manager::m_wake_sig = 0;
+sig_info_t manager::m_wait_infos[manager::batch_size];
+std::size_t manager::m_wait_count = 0;
+std::mutex manager::m_dispatch_mutex;
+std::atomic<std::size_t> manager::m_readers = {0};
+details::executor<manager::handler_task, manager::priority_levels> manager::m_executor;
 std::mutex manager::m_handlers_mutex;
-manager::handlers_map_t manager::m_handlers;
+std::atomic<manager::handler_node*> manager::m_handlers[_NSIG];
+std::atomic<std::uint64_t> manager::m_generation = {0};
+std::atomic<std::size_t> manager::m_prioritized = {0};
+std::vector<sig_info_t> manager::m_deferred_infos[manager::priority_levels];
+std::vector<manager::handler_node*> manager::m_retired;
+std::atomic_bool manager::m_has_retired = {false};
+std::vector<sig_info_t> manager::m_batch_infos[_NSIG];
+std::uint64_t manager::m_batch_mask = 0;
+std::uint64_t manager::m_handler_ids = 0;
+manager::rate_state manager::m_rates[_NSIG];
+details::timer_wheel<_NSIG> manager::m_timers;
+sig_num_t manager::m_timer_sig = 0;
+std::uint32_t manager::m_timer_serial = 0;
+std::atomic<manager::handler_node*> manager::m_timer_handlers[manager::max_timers];
+::timer_t manager::m_timer_handles[manager::max_timers];
+bool manager::m_is_periodic[manager::max_timers];
+std::atomic_bool manager::m_is_fired[manager::max_timers];
 manager::signals_queue_t manager::m_sig_queue;
+manager::records_queue_t manager::m_record_queue;
+manager::counters_t manager::m_queued;
+manager::counters_t manager::m_dropped;
+manager::counters_t manager::m_coalesced;
+std::atomic<std::uint64_t> manager::m_pending_mask = {0};
+manager::counters_t manager::m_pending_counts;
+#if defined(SIGNALS_MANAGER_USE_STATS)
+manager::signal_histograms manager::m_stats[_NSIG];
+std::atomic<std::size_t> manager::m_queue_depth = {0};
+std::atomic<std::size_t> manager::m_max_queue_depth = {0};
+#endif
+
+manager::manager(backend b)
+    : manager(make_options(b))
+{}
+
+manager::manager(const options& opts)
+{
+    m_backend = opts.delivery;
+    m_overflow = opts.overflow;
+    m_thread_options = opts.thread;
+    m_timer_sig = opts.timer_signal;
+    m_wake_sig = opts.wake_signal;
+    if (! m_sig_queue.reset(opts.queue_capacity) || ! m_record_queue.reset(opts.queue_capacity)) {
+        m_sig_queue.reset(max_queue_capacity);
+        m_record_queue.reset(max_queue_capacity);
+    }
+    for (sig_num_t sig = 0; sig < _NSIG; ++sig) {
+        m_queued[sig].store(0, std::memory_order_relaxed);
+        m_dropped[sig].store(0, std::memory_order_relaxed);
+        m_coalesced[sig].store(0, std::memory_order_relaxed);
+#if defined(SIGNALS_MANAGER_USE_STATS)
+        m_stats[sig].latency.reset();
+        m_stats[sig].duration.reset();
+        m_stats[sig].handled.store(0, std::memory_order_relaxed);
+#endif
+    }
+#if defined(SIGNALS_MANAGER_USE_STATS)
+    m_max_queue_depth.store(0, std::memory_order_relaxed);
+#endif
+    for (std::vector<sig_info_t>& infos : m_deferred_infos) {
+        infos.reserve(m_sig_queue.capacity());
+    }
+    if (opts.workers > 0) {
+        m_executor.start(opts.workers, _NSIG);
+    } else {
+        m_executor.stop();
+    }
+}
+
+void manager::handler_task::operator()()
+{
+    switch (p_handler->kind) {
+    case handler_kind::queued:
+        call(*p_handler, sig, &info, 1);
+        break;
+    case handler_kind::compact:
+        call(*p_handler, sig, &record, 1);
+        break;
+    case handler_kind::batch:
+        call(*p_handler, sig, infos.data(), infos.size());
+        break;
+    case handler_kind::coalesced:
+        call(*p_handler, sig, nullptr, count);
+        break;
+    case handler_kind::timer:
+        dispatch_timer(info);
+        break;
+    case handler_kind::none:
+        break;
+    }
+    end_dispatch();
+}
+
+bool manager::apply_thread_options()
+{
+    const thread_options& opts = m_thread_options;
+    if (! opts.name.empty() && ! details::set_thread_name(opts.name)) {
+        return false;
+    }
+    if (! opts.cpus.empty() && ! details::set_thread_affinity(opts.cpus)) {
+        return false;
+    }
+    if ((opts.policy != sched_policy::other) && ! details::set_thread_scheduling(opts.policy, opts.priority)) {
+        return false;
+    }
+    if (opts.lock_memory) {
+        const bool is_locked = details::lock_thread_stack(opts.locked_stack_size)
+            && details::lock_memory(&m_sig_queue, sizeof(m_sig_queue))
+            && details::lock_memory(&m_record_queue, sizeof(m_record_queue));
+        if (! is_locked) {
+            release_thread_options();
+            return false;
+        }
+    }
+    return true;
+}
+
+void manager::arm_notify_timer()
+{
+    const std::uint64_t deadline = m_timers.next_deadline();
+    m_next_deadline.store(deadline, std::memory_order_relaxed);
+    if (! m_is_attached || (deadline == m_armed_deadline)) {
+        return;
+    }
+
+    // Rearming clears the expiration of the fired timer, so the descriptor
+    // stays readable only while a deadline is due.
+    m_armed_deadline = deadline;
+    m_notify_timer.arm((deadline == m_timers.never) ? 0 : deadline * 1000000);
+}
+
+void manager::begin_dispatch()
+{
+    // Pairs with the fence in 'reclaim': either the writer sees the reader
+    // or the reader sees the new handler.
+    m_readers.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+void manager::call(const handler_node& handler, sig_num_t sig, const void* p_infos, std::size_t count)
+{
+#if defined(SIGNALS_MANAGER_USE_STATS)
+    const std::uint64_t start = details::monotonic_ns();
+    handler.func(sig, p_infos, count);
+    // Handler calls of a signal are serialized by the dispatch mutex or by
+    // the worker strand, so the histograms have a single writer.
+    signal_histograms& stats = m_stats[sig];
+    stats.duration.record(details::monotonic_ns() - start);
+    stats.handled.store(stats.handled.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+#else
+    handler.func(sig, p_infos, count);
+#endif
+}
 
 void manager::clear()
 {
     stop_processing();
+    close_notify_fd();
+    m_executor.wait_idle();
 
-    for (const handlers_map_t::value_type& handler : m_handlers) {
-        details::unregister_signal_handler(handler.first);
-        details::unblock_signal(handler.first);
+    std::lock_guard<std::mutex> lock(m_handlers_mutex);
+    for (std::size_t slot = 0; slot < max_timers; ++slot) {
+        release_timer(slot);
+    }
+    for (sig_num_t sig = 1; sig < _NSIG; ++sig) {
+        erase(sig);
+        m_batch_infos[sig].clear();
+    }
+    reclaim();
+    m_batch_mask = 0;
+    m_timers.clear();
+    for (rate_state& state : m_rates) {
+        state = rate_state();
     }
 
-    m_handlers.clear();
-    while (! m_sig_queue.empty()) {
-        sig_info_t sig_info;
-        m_sig_queue.pop(sig_info);
+    queued_record<sig_info_t> infos[batch_size];
+    queued_record<sig_record> records[batch_size];
+    std::size_t count = 0;
+    while ((count = m_sig_queue.pop_bulk(infos, batch_size) + m_record_queue.pop_bulk(records, batch_size)) > 0) {
+#if defined(SIGNALS_MANAGER_USE_STATS)
+        m_queue_depth.fetch_sub(count, std::memory_order_relaxed);
+#endif
+    }
+    m_pending_mask.store(0, std::memory_order_relaxed);
+    m_has_pending.store(false, std::memory_order_relaxed);
+    for (sig_num_t sig = 0; sig < _NSIG; ++sig) {
+        m_queued[sig].store(0, std::memory_order_relaxed);
+        m_pending_counts[sig].store(0, std::memory_order_relaxed);
+#if defined(SIGNALS_MANAGER_USE_STATS)
+        m_stats[sig].pending_since.store(0, std::memory_order_relaxed);
+#endif
     }
 }
 
-void manager::erase(sig_num_t sig)
+void manager::close_backend(const details::sig_set_t& set)
 {
-    handlers_map_t::iterator it = m_handlers.find(sig);
-    if (it == m_handlers.cend()) {
+    m_sig_fd.close();
+    if (! m_is_waiting) {
         return;
     }
 
-    m_handlers.erase(it);
-    details::unregister_signal_handler(sig);
-    details::unblock_signal(sig);
+    // Wait for the wakers that have seen the waiting thread and drain the
+    // wakeup signals directed to it, so they are not left pending.
+    m_is_waiting = false;
+    while (m_wakes.load() != 0) {
+        std::this_thread::yield();
+    }
+
+    const ::timespec ts = {0, 0};
+    sig_info_t info;
+    begin_dispatch();
+    while (::sigtimedwait(&set, &info, &ts) > 0) {
+        if (! is_wake(info)) {
+            dispatch(info);
+        }
+    }
+    std::uint64_t coalesced_mask = 0;
+    dispatch_batches(all_levels);
+    dispatch_coalesced(coalesced_mask, all_levels);
+    end_dispatch();
 }
 
-void manager::processing()
+void manager::close_notify_fd()
+{
+    std::unique_lock<std::mutex> lock(m_dispatch_mutex, std::defer_lock);
+    if (! lock.try_lock() || ! m_is_attached) {
+        return;
+    }
+
+    m_is_attached = false;
+    if (m_backend == backend::sigaction) {
+        details::block_sigset(m_attached_set);
+    }
+    m_notify_fd.close();
+    m_notify_timer.close();
+    m_armed_deadline = m_timers.never;
+    m_sig_fd.close();
+    m_event.reset();
+}
+
+bool manager::cancel_timer(timer_id_t id)
 {
+    if (id == invalid_timer) {
+        return false;
+    }
+
     std::lock_guard<std::mutex> lock(m_handlers_mutex);
+    const std::size_t slot = (id - 1) % max_timers;
+    const handler_node* p_timer = m_timer_handlers[slot].load(std::memory_order_relaxed);
+    if ((p_timer == nullptr) || (p_timer->id != id)) {
+        return false;
+    }
+    release_timer(slot);
+    return true;
+}
 
-    details::sig_set_t set;
-    ::sigemptyset(&set);
+std::uint64_t manager::coalesced(sig_num_t sig) const
+{
+    return is_valid_signal(sig) ? m_coalesced[sig].load(std::memory_order_relaxed) : 0;
+}
 
-    for (const handlers_map_t::value_type& handler : m_handlers) {
-        if (::sigaddset(&set, handler.first) != 0) {
-            return;
+void manager::dispatch(const sig_info_t& info)
+{
+    const sig_num_t sig = info.si_signo;
+    const handler_node* p_handler = m_handlers[sig].load(std::memory_order_acquire);
+    if (p_handler == nullptr) {
+        return;
+    }
+
+    switch (p_handler->kind) {
+    case handler_kind::queued:
+        if (p_handler->limit.policy != rate_policy::none) {
+            dispatch_limited(*p_handler, sig, &info, 1);
+        } else if (m_executor.is_running()) {
+            submit(handler_task{p_handler, sig, 1, info, sig_record(), {}});
+        } else {
+            call(*p_handler, sig, &info, 1);
+        }
+        break;
+    case handler_kind::compact:
+        dispatch(to_record(info));
+        break;
+    case handler_kind::batch:
+        m_batch_infos[sig].push_back(info);
+        m_batch_mask |= sig_bit(sig);
+        break;
+    case handler_kind::coalesced:
+        mark_pending(sig);
+        break;
+    case handler_kind::timer:
+        if (m_executor.is_running()) {
+            submit(handler_task{p_handler, sig, 1, info, sig_record(), {}});
+        } else {
+            dispatch_timer(info);
         }
+        break;
+    case handler_kind::none:
+        break;
     }
+}
 
-    m_is_stop = false;
-    while (! m_is_stop) {
-        details::unblock_sigset(set);
-        wait();
-        details::block_sigset(set);
-
-        sig_info_t info = {};
-        while (pop_signal(info)) {
-            const handlers_map_t::const_iterator it = m_handlers.find(info.si_signo);
-            if (it != m_handlers.cend()) {
-                it->second(info.si_signo, info);
+void manager::dispatch(const sig_record& record)
+{
+    const sig_num_t sig = record.signo;
+    const handler_node* p_handler = m_handlers[sig].load(std::memory_order_acquire);
+    if (p_handler == nullptr) {
+        return;
+    }
+    if (p_handler->kind != handler_kind::compact) {
+        // The handler has been replaced by one taking the full record.
+        dispatch(to_info(record));
+        return;
+    }
+
+    if (p_handler->limit.policy != rate_policy::none) {
+        const sig_info_t info = to_info(record);
+        dispatch_limited(*p_handler, sig, &info, 1);
+    } else if (m_executor.is_running()) {
+        submit(handler_task{p_handler, sig, 1, sig_info_t(), record, {}});
+    } else {
+        call(*p_handler, sig, &record, 1);
+    }
+}
+
+void manager::dispatch_batches(std::size_t level)
+{
+    std::uint64_t mask = m_batch_mask;
+    while (mask != 0) {
+        const sig_num_t sig = __builtin_ctzll(mask) + 1;
+        mask &= mask - 1;
+
+        const handler_node* p_handler = m_handlers[sig].load(std::memory_order_acquire);
+        const bool is_batch = (p_handler != nullptr) && (p_handler->kind == handler_kind::batch);
+        if (is_batch && (level != all_levels) && (static_cast<std::size_t>(p_handler->prio) != level)) {
+            continue;
+        }
+        m_batch_mask &= ~sig_bit(sig);
+
+        std::vector<sig_info_t>& infos = m_batch_infos[sig];
+        if (is_batch) {
+            if (m_executor.is_running()) {
+                submit(handler_task{p_handler, sig, infos.size(), sig_info_t(), sig_record(), std::move(infos)});
+            } else {
+                call(*p_handler, sig, infos.data(), infos.size());
             }
         }
+        infos.clear();
     }
 }
 
-void manager::processing_to(const std::chrono::milliseconds& msec, bool exit_after_timeout)
+std::size_t manager::dispatch_coalesced(std::uint64_t& mask, std::size_t level)
 {
-    std::lock_guard<std::mutex> lock(m_handlers_mutex);
+    mask |= m_pending_mask.exchange(0, std::memory_order_acquire);
 
-    details::sig_set_t set;
-    ::sigemptyset(&set);
+    std::size_t total = 0;
+    std::uint64_t bits = mask;
+    while (bits != 0) {
+        const sig_num_t sig = __builtin_ctzll(bits) + 1;
+        bits &= bits - 1;
 
-    for (const handlers_map_t::value_type& handler : m_handlers) {
-        if (::sigaddset(&set, handler.first) != 0) {
-            return;
+        const handler_node* p_handler = m_handlers[sig].load(std::memory_order_acquire);
+        const bool is_coalesced = (p_handler != nullptr) && (p_handler->kind == handler_kind::coalesced);
+        if (is_coalesced && (level != all_levels) && (static_cast<std::size_t>(p_handler->prio) != level)) {
+            continue;
+        }
+        mask &= ~sig_bit(sig);
+
+#if defined(SIGNALS_MANAGER_USE_STATS)
+        const std::uint64_t since = m_stats[sig].pending_since.exchange(0, std::memory_order_relaxed);
+#endif
+        const std::uint64_t count = m_pending_counts[sig].exchange(0, std::memory_order_relaxed);
+#if defined(SIGNALS_MANAGER_USE_STATS)
+        if ((count != 0) && (since != 0)) {
+            m_stats[sig].latency.record(details::monotonic_ns() - since);
+        }
+#endif
+        if ((count != 0) && is_coalesced) {
+            if (p_handler->limit.policy != rate_policy::none) {
+                dispatch_limited(*p_handler, sig, nullptr, count);
+            } else if (m_executor.is_running()) {
+                submit(handler_task{p_handler, sig, count, sig_info_t(), sig_record(), {}});
+            } else {
+                call(*p_handler, sig, nullptr, count);
+            }
+            total += count;
         }
     }
+    return total;
+}
 
-    m_is_stop = false;
-    while (! m_is_stop) {
-        details::unblock_sigset(set);
-        wait(msec);
-        details::block_sigset(set);
-
-        sig_info_t info = {};
-        while (pop_signal(info)) {
-            const handlers_map_t::const_iterator it = m_handlers.find(info.si_signo);
-            if (it != m_handlers.cend()) {
-                it->second(info.si_signo, info);
+std::size_t manager::dispatch_cycle(std::size_t max_count)
+{
+    const bool is_ordered = (m_prioritized.load(std::memory_order_relaxed) != 0);
+    std::size_t count = dispatch_records(max_count, is_ordered);
+
+    // The drained records are dispatched from the highest priority to the
+    // lowest one, the batch and coalesced handlers of a level are called
+    // right after its records.
+    std::uint64_t coalesced_mask = 0;
+    if (is_ordered) {
+        for (std::size_t level = priority_levels; level-- > 0;) {
+            for (const sig_info_t& info : m_deferred_infos[level]) {
+                dispatch(info);
             }
+            m_deferred_infos[level].clear();
+            dispatch_batches(level);
+            count += dispatch_coalesced(coalesced_mask, level);
         }
+    }
+    dispatch_batches(all_levels);
+    count += dispatch_coalesced(coalesced_mask, all_levels);
+    dispatch_timers();
+    return count;
+}
 
-        if (exit_after_timeout) {
+void manager::dispatch_limited(const handler_node& handler, sig_num_t sig, const sig_info_t* p_info,
+                               std::size_t count)
+{
+    rate_state& state = m_rates[sig];
+    if (state.handler_id != handler.id) {
+        // The handler has been replaced, the window and the suppressed
+        // signals of the old one are discarded.
+        m_timers.cancel(sig);
+        state = rate_state();
+        state.handler_id = handler.id;
+    }
+    if (p_info != nullptr) {
+        state.info = *p_info;
+    }
+    state.count += count;
+
+    const rate_limit& limit = handler.limit;
+    const std::uint64_t deadline = now_ms() + limit.interval.count();
+    const bool is_window = (m_timers.deadline(sig) != m_timers.never);
+    if ((limit.policy == rate_policy::debounce) || ! is_window) {
+        // Debounce window is extended by each signal, throttle window is
+        // started by the first one.
+        m_timers.schedule(sig, deadline);
+    }
+    if (! is_window && limit.leading) {
+        fire(handler, sig, state);
+        return;
+    }
+    state.is_pending = limit.trailing;
+    if (! limit.trailing) {
+        state.count = 0;
+    }
+}
+
+std::size_t manager::dispatch_pending(std::size_t max_count)
+{
+    std::unique_lock<std::mutex> lock(m_dispatch_mutex, std::defer_lock);
+    if (! lock.try_lock()) {
+        return 0;
+    }
+    if (m_is_attached) {
+        update_sigset(m_attached_set, m_attached_generation);
+    }
+
+    // The pending flag and the event are reset before draining, so a signal
+    // received during the draining leaves them set.
+    m_has_pending.exchange(false);
+    if (m_is_attached) {
+        m_event.reset();
+    }
+    begin_dispatch();
+    const std::size_t count = dispatch_cycle(max_count);
+    if (! m_sig_queue.empty() || ! m_record_queue.empty()) {
+        m_has_pending.store(true, std::memory_order_release);
+        if (m_is_attached) {
+            m_event.post();
+        }
+    }
+    arm_notify_timer();
+    end_dispatch();
+    return count;
+}
+
+template<typename TInfo>
+std::size_t manager::dispatch_queue(details::signals_queue_t<queued_record<TInfo>, max_queue_capacity>& queue,
+                                    std::size_t max_count, bool is_ordered)
+{
+    queued_record<TInfo> records[batch_size];
+    std::size_t total = 0;
+    while (total < max_count) {
+        const std::size_t size = std::min(max_count - total, batch_size);
+        const std::size_t count = queue.pop_bulk(records, size);
+#if defined(SIGNALS_MANAGER_USE_STATS)
+        const std::uint64_t now = (count != 0) ? details::monotonic_ns() : 0;
+        m_queue_depth.fetch_sub(count, std::memory_order_relaxed);
+#endif
+        for (std::size_t i = 0; i < count; ++i) {
+            const sig_num_t sig = signo(records[i].info);
+            if (m_overflow == overflow_policy::coalesce) {
+                m_queued[sig].fetch_sub(1, std::memory_order_relaxed);
+            }
+#if defined(SIGNALS_MANAGER_USE_STATS)
+            m_stats[sig].latency.record(now - std::min(now, records[i].arrival_ns));
+#endif
+            dispatch_record(records[i].info, is_ordered);
+        }
+        total += count;
+        if (count < size) {
             break;
         }
     }
+    return total;
 }
 
-void manager::remove_handler(sig_num_t sig)
+void manager::dispatch_record(const sig_info_t& info, bool is_ordered)
 {
-    std::unique_lock<std::mutex> lock(m_handlers_mutex, std::defer_lock);
-    if (! lock.try_lock()) {
+    if (! is_ordered) {
+        dispatch(info);
         return;
     }
-    erase(sig);
+
+    const handler_node* p_handler = m_handlers[info.si_signo].load(std::memory_order_acquire);
+    const priority prio = (p_handler != nullptr) ? p_handler->prio : priority::normal;
+    m_deferred_infos[static_cast<std::size_t>(prio)].push_back(info);
 }
 
-bool manager::reset_handler(sig_num_t sig, std::function<void()> func)
+void manager::dispatch_record(const sig_record& record, bool is_ordered)
 {
-    return reset_handler(sig, [func](sig_num_t, const sig_info_t&) -> void { func(); });
+    if (! is_ordered) {
+        dispatch(record);
+        return;
+    }
+    dispatch_record(to_info(record), true);
 }
 
-bool manager::reset_handler(sig_num_t sig, sig_handler_fn_t func)
+std::size_t manager::dispatch_records(std::size_t max_count, bool is_ordered)
 {
-    std::unique_lock<std::mutex> lock(m_handlers_mutex, std::defer_lock);
-    if (! lock.try_lock()) {
-        return false;
+    for (std::size_t i = 0; i < m_wait_count; ++i) {
+        dispatch_record(m_wait_infos[i], is_ordered);
     }
+    std::size_t total = m_wait_count;
+    m_wait_count = 0;
 
-    std::pair<handlers_map_t::iterator, bool> rc = m_handlers.emplace(sig, func);
-    if (! rc.second) {
-        rc.first->second = func;
-        return true;
+    sig_info_t infos[batch_size];
+    if (m_sig_fd.is_open()) {
+        while (total < max_count) {
+            const std::size_t size = std::min(max_count - total, batch_size);
+            const std::size_t count = m_sig_fd.read(infos, size);
+            for (std::size_t i = 0; i < count; ++i) {
+                dispatch_record(infos[i], is_ordered);
+            }
+            total += count;
+            if (count < size) {
+                break;
+            }
+        }
     }
-    if (! details::block_signal(sig)) {
-        erase(sig);
-        return false;
+
+    if (total < max_count) {
+        total += dispatch_queue(m_record_queue, max_count - total, is_ordered);
     }
-    if (! details::register_signal_handler(sig, &on_signal_fn)) {
-        erase(sig);
-        return false;
+    if (total < max_count) {
+        total += dispatch_queue(m_sig_queue, max_count - total, is_ordered);
     }
-    return true;
+    return total;
 }
 
-bool manager::set_handler(sig_num_t sig, std::function<void()> func)
+void manager::dispatch_signals()
 {
-    return set_handler(sig, [func](sig_num_t, const sig_info_t&) -> void { func(); });
+    begin_dispatch();
+    dispatch_cycle(std::numeric_limits<std::size_t>::max());
+    end_dispatch();
 }
 
-bool manager::set_handler(sig_num_t sig, sig_handler_fn_t func)
+void manager::dispatch_timer(const sig_info_t& info)
 {
-    std::unique_lock<std::mutex> lock(m_handlers_mutex, std::defer_lock);
-    if (! lock.try_lock()) {
+    if (info.si_code != SI_TIMER) {
+        return;
+    }
+    const timer_id_t id = static_cast<timer_id_t>(reinterpret_cast<std::uintptr_t>(info.si_value.sival_ptr));
+    if (id == invalid_timer) {
+        return;
+    }
+
+    // An expiration of a cancelled timer may still be queued, so the
+    // identifier of the timer in the slot is checked.
+    const std::size_t slot = (id - 1) % max_timers;
+    const handler_node* p_timer = m_timer_handlers[slot].load(std::memory_order_acquire);
+    if ((p_timer == nullptr) || (p_timer->id != id)) {
+        return;
+    }
+    call(*p_timer, info.si_signo, &info, 1);
+    m_is_fired[slot].store(true, std::memory_order_release);
+}
+
+void manager::dispatch_timers()
+{
+    if (m_timers.empty()) {
+        return;
+    }
+
+    const std::uint64_t now = now_ms();
+    m_timers.expire(now, [now](std::size_t id) {
+        const sig_num_t sig = static_cast<sig_num_t>(id);
+        const handler_node* p_handler = m_handlers[sig].load(std::memory_order_acquire);
+        rate_state& state = m_rates[sig];
+        if ((p_handler == nullptr) || (p_handler->id != state.handler_id)) {
+            state = rate_state();
+            return;
+        }
+        if (! state.is_pending) {
+            return;
+        }
+
+        fire(*p_handler, sig, state);
+        if (p_handler->limit.policy == rate_policy::throttle) {
+            // The trailing call starts the next throttle window.
+            m_timers.schedule(sig, now + p_handler->limit.interval.count());
+        }
+    });
+}
+
+std::uint64_t manager::dropped(sig_num_t sig) const
+{
+    return is_valid_signal(sig) ? m_dropped[sig].load(std::memory_order_relaxed) : 0;
+}
+
+void manager::end_dispatch()
+{
+    m_readers.fetch_sub(1, std::memory_order_release);
+
+    if (m_has_retired.load(std::memory_order_acquire)) {
+        std::unique_lock<std::mutex> lock(m_handlers_mutex, std::defer_lock);
+        if (lock.try_lock()) {
+            reclaim();
+        }
+    }
+}
+
+void manager::erase(sig_num_t sig)
+{
+    handler_node* p_handler = m_handlers[sig].exchange(nullptr, std::memory_order_acq_rel);
+    if (p_handler == nullptr) {
+        return;
+    }
+    if (p_handler->prio != priority::normal) {
+        m_prioritized.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    retire(p_handler);
+    m_generation.fetch_add(1, std::memory_order_release);
+    details::unregister_signal_handler(sig);
+    details::unblock_signal(sig);
+}
+
+void manager::fire(const handler_node& handler, sig_num_t sig, rate_state& state)
+{
+    const std::size_t count = state.count;
+    state.count = 0;
+    state.is_pending = false;
+
+    const bool is_running = m_executor.is_running();
+    switch (handler.kind) {
+    case handler_kind::queued:
+        if (is_running) {
+            submit(handler_task{&handler, sig, 1, state.info, sig_record(), {}});
+        } else {
+            call(handler, sig, &state.info, 1);
+        }
+        break;
+    case handler_kind::compact: {
+        const sig_record record = to_record(state.info);
+        if (is_running) {
+            submit(handler_task{&handler, sig, 1, sig_info_t(), record, {}});
+        } else {
+            call(handler, sig, &record, 1);
+        }
+        break;
+    }
+    case handler_kind::coalesced:
+        if (is_running) {
+            submit(handler_task{&handler, sig, count, sig_info_t(), sig_record(), {}});
+        } else {
+            call(handler, sig, nullptr, count);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+bool manager::install(sig_num_t sig, details::sig_action_fn_t on_signal)
+{
+    return details::block_signal(sig) && details::register_signal_handler(sig, on_signal);
+}
+
+bool manager::install_handler(sig_num_t sig, handler_node&& node, bool is_reset)
+{
+    if (! is_valid_signal(sig)) {
+        return false;
+    }
+    if ((node.kind == handler_kind::coalesced) && (sig >= SIGRTMIN)) {
+        return false;
+    }
+    if (! is_valid_limit(node.limit)) {
         return false;
     }
 
-    std::pair<handlers_map_t::iterator, bool> rc = m_handlers.emplace(sig, func);
-    if (! rc.second) {
+    std::lock_guard<std::mutex> lock(m_handlers_mutex);
+    const handler_node* p_installed = m_handlers[sig].load(std::memory_order_relaxed);
+    if ((p_installed != nullptr) && ! is_reset) {
         return false;
     }
-    if (! details::block_signal(sig)) {
+    const bool is_installed = (p_installed != nullptr);
+    const details::sig_action_fn_t on_signal = trampoline(node.kind);
+    const bool is_same_trampoline = is_installed && (trampoline(p_installed->kind) == on_signal);
+    if (is_installed && (p_installed->prio != priority::normal)) {
+        m_prioritized.fetch_sub(1, std::memory_order_relaxed);
+    }
+    if (node.prio != priority::normal) {
+        m_prioritized.fetch_add(1, std::memory_order_relaxed);
+    }
+    node.id = ++m_handler_ids;
+
+    retire(m_handlers[sig].exchange(new handler_node(std::move(node)), std::memory_order_acq_rel));
+    m_generation.fetch_add(1, std::memory_order_release);
+    if (is_same_trampoline) {
+        return true;
+    }
+
+    if (! install(sig, on_signal)) {
         erase(sig);
         return false;
     }
-    if (! details::register_signal_handler(sig, &on_signal_fn)) {
-        erase(sig);
+    return true;
+}
+
+bool manager::make_sigset(details::sig_set_t& set)
+{
+    ::sigemptyset(&set);
+    for (sig_num_t sig = 1; sig < _NSIG; ++sig) {
+        if ((m_handlers[sig].load(std::memory_order_relaxed) != nullptr) && (::sigaddset(&set, sig) != 0)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool manager::open_backend(details::sig_set_t& set)
+{
+    if (m_is_attached) {
         return false;
     }
+    if (m_backend == backend::signalfd) {
+        return m_sig_fd.open(set);
+    }
+    if (m_backend == backend::sigwait) {
+        // A pending standard signal discards the next one directed to the
+        // thread, so only a queued real-time signal is used for wakeups.
+        if ((m_wake_sig < SIGRTMIN) || (m_wake_sig > SIGRTMAX) || ! details::block_signal(m_wake_sig)) {
+            return false;
+        }
+        ::sigaddset(&set, m_wake_sig);
+        m_wait_thread = ::pthread_self();
+        m_is_waiting = true;
+    }
     return true;
 }
 
+int manager::open_notify_fd()
+{
+    std::unique_lock<std::mutex> lock(m_dispatch_mutex, std::defer_lock);
+    if (! lock.try_lock() || (m_backend == backend::sigwait)) {
+        return -1;
+    }
+    if (m_is_attached) {
+        return m_notify_fd.fd();
+    }
+    m_attached_generation = m_generation.load(std::memory_order_acquire);
+    if (! make_sigset(m_attached_set)) {
+        return -1;
+    }
+    m_event.reset();
+
+    // The timer makes the descriptor readable at the nearest deadline of the
+    // rate limits, so the deferred calls are made without a signal.
+    if (! m_notify_fd.open() || ! m_notify_fd.add(m_event.fd()) ||
+        ! m_notify_timer.open() || ! m_notify_fd.add(m_notify_timer.fd())) {
+        m_notify_fd.close();
+        m_notify_timer.close();
+        return -1;
+    }
+    if (m_backend == backend::signalfd) {
+        // Signals of the threads that have unblocked them are passed through
+        // the queue and the event, so both descriptors are watched.
+        if (! m_sig_fd.open(m_attached_set) || ! m_notify_fd.add(m_sig_fd.fd())) {
+            m_notify_fd.close();
+            m_notify_timer.close();
+            m_sig_fd.close();
+            return -1;
+        }
+    } else {
+        details::unblock_sigset(m_attached_set);
+    }
+
+    m_is_attached = true;
+    m_armed_deadline = m_timers.never;
+    arm_notify_timer();
+    return m_notify_fd.fd();
+}
+
+void manager::processing()
+{
+    std::lock_guard<std::mutex> lock(m_dispatch_mutex);
+
+    std::uint64_t generation = m_generation.load(std::memory_order_acquire);
+    details::sig_set_t set;
+    if (! make_sigset(set) || ! open_backend(set)) {
+        return;
+    }
+
+    m_is_stop = false;
+    while (! m_is_stop) {
+        std::chrono::milliseconds timeout = std::chrono::milliseconds::max();
+        if (timers_timeout(timeout)) {
+            wait(set, &timeout);
+        } else {
+            wait(set);
+        }
+        dispatch_signals();
+        update_sigset(set, generation);
+    }
+    close_backend(set);
+}
+
+void manager::processing_to(const std::chrono::milliseconds& msec, bool exit_after_timeout)
+{
+    std::lock_guard<std::mutex> lock(m_dispatch_mutex);
+
+    std::uint64_t generation = m_generation.load(std::memory_order_acquire);
+    details::sig_set_t set;
+    if (! make_sigset(set) || ! open_backend(set)) {
+        return;
+    }
+
+    m_is_stop = false;
+    while (! m_is_stop) {
+        std::chrono::milliseconds timeout = msec;
+        timers_timeout(timeout);
+        wait(set, &timeout);
+        dispatch_signals();
+        update_sigset(set, generation);
+
+        if (exit_after_timeout) {
+            break;
+        }
+    }
+    close_backend(set);
+}
+
+template<typename TInfo>
+void manager::push(details::signals_queue_t<queued_record<TInfo>, max_queue_capacity>& queue, const TInfo& info)
+{
+    const sig_num_t sig = signo(info);
+    queued_record<TInfo> record;
+    record.info = info;
+#if defined(SIGNALS_MANAGER_USE_STATS)
+    record.arrival_ns = details::monotonic_ns();
+    // The depth is incremented before the push, so the consumer never sees
+    // it lower than the number of queued records.
+    const std::size_t depth = m_queue_depth.fetch_add(1, std::memory_order_relaxed) + 1;
+#endif
+    if (queue.try_push(record)) {
+        if (m_overflow == overflow_policy::coalesce) {
+            m_queued[sig].fetch_add(1, std::memory_order_relaxed);
+        }
+#if defined(SIGNALS_MANAGER_USE_STATS)
+        std::size_t max_depth = m_max_queue_depth.load(std::memory_order_relaxed);
+        while ((depth > max_depth) && ! m_max_queue_depth.compare_exchange_weak(max_depth, depth, std::memory_order_relaxed)) {}
+#endif
+        return;
+    }
+#if defined(SIGNALS_MANAGER_USE_STATS)
+    m_queue_depth.fetch_sub(1, std::memory_order_relaxed);
+#endif
+
+    switch (m_overflow) {
+    case overflow_policy::drop_newest:
+        break;
+    case overflow_policy::drop_oldest: {
+        queued_record<TInfo> oldest;
+        if (queue.pop(oldest)) {
+            m_dropped[signo(oldest.info)].fetch_add(1, std::memory_order_relaxed);
+            if (queue.try_push(record)) {
+                return;
+            }
+#if defined(SIGNALS_MANAGER_USE_STATS)
+            m_queue_depth.fetch_sub(1, std::memory_order_relaxed);
+#endif
+        }
+        break;
+    }
+    case overflow_policy::coalesce:
+        if (m_queued[sig].load(std::memory_order_relaxed) > 0) {
+            m_coalesced[sig].fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        break;
+    }
+    m_dropped[sig].fetch_add(1, std::memory_order_relaxed);
+}
+
+void manager::push_signal(const sig_info_t& info)
+{
+    push(m_sig_queue, info);
+}
+
+void manager::push_signal(const sig_record& record)
+{
+    push(m_record_queue, record);
+}
+
+void manager::reclaim()
+{
+    // Retired handlers are destroyed when no dispatch cycle or handler task,
+    // which could use them, is running.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_readers.load(std::memory_order_acquire) != 0) {
+        m_has_retired.store(! m_retired.empty(), std::memory_order_release);
+        return;
+    }
+
+    for (handler_node* p_node : m_retired) {
+        delete p_node;
+    }
+    m_retired.clear();
+    m_has_retired.store(false, std::memory_order_release);
+}
+
+void manager::release_thread_options()
+{
+    if (m_thread_options.lock_memory) {
+        details::unlock_thread_stack(m_thread_options.locked_stack_size);
+        details::unlock_memory(&m_sig_queue, sizeof(m_sig_queue));
+        details::unlock_memory(&m_record_queue, sizeof(m_record_queue));
+    }
+}
+
+void manager::release_timer(std::size_t slot)
+{
+    handler_node* p_timer = m_timer_handlers[slot].exchange(nullptr, std::memory_order_acq_rel);
+    if (p_timer == nullptr) {
+        return;
+    }
+    details::delete_timer(m_timer_handles[slot]);
+    retire(p_timer);
+}
+
+void manager::remove_handler(sig_num_t sig)
+{
+    if (! is_valid_signal(sig)) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_handlers_mutex);
+    if (sig == m_timer_sig) {
+        // Expirations of the timers would kill the process without the handler.
+        for (std::size_t slot = 0; slot < max_timers; ++slot) {
+            release_timer(slot);
+        }
+    }
+    erase(sig);
+}
+
+void manager::retire(handler_node* p_node)
+{
+    if (p_node == nullptr) {
+        return;
+    }
+
+    m_retired.push_back(p_node);
+    reclaim();
+}
+
 void manager::signals_processing()
 {
     processing();
@@ -199,6 +1096,30 @@ void manager::signals_processing(const std::chrono::milliseconds& msec, bool exi
     processing_to(msec, exit_after_timeout);
 }
 
+manager_stats manager::stats() const
+{
+    manager_stats result;
+#if defined(SIGNALS_MANAGER_USE_STATS)
+    result.max_queue_depth = m_max_queue_depth.load(std::memory_order_relaxed);
+#endif
+    for (sig_num_t sig = 1; sig < _NSIG; ++sig) {
+        signal_stats stats;
+        stats.sig = sig;
+        stats.dropped = m_dropped[sig].load(std::memory_order_relaxed);
+        stats.coalesced = m_coalesced[sig].load(std::memory_order_relaxed);
+#if defined(SIGNALS_MANAGER_USE_STATS)
+        stats.handled = m_stats[sig].handled.load(std::memory_order_relaxed);
+        stats.latency = m_stats[sig].latency.get();
+        stats.duration = m_stats[sig].duration.get();
+#endif
+        const bool has_handler = (m_handlers[sig].load(std::memory_order_acquire) != nullptr);
+        if (has_handler || (stats.handled != 0) || (stats.dropped != 0) || (stats.coalesced != 0)) {
+            result.signals.push_back(stats);
+        }
+    }
+    return result;
+}
+
 void manager::stop_processing()
 {
     m_is_stop = true;
@@ -209,18 +1130,185 @@ void manager::stop_processing()
     }
 }
 
-void manager::threaded_signals_processing(const std::chrono::milliseconds& msec)
+manager::timer_id_t manager::start_timer(const std::chrono::nanoseconds& delay,
+                                         const std::chrono::nanoseconds& period, handler_node&& node)
+{
+    if ((delay.count() < 0) || (period.count() < 0) || ! is_valid_signal(m_timer_sig) || (m_timer_sig < SIGRTMIN)) {
+        return invalid_timer;
+    }
+
+    // The dispatcher of the timer signal is installed by the first timer and
+    // stays installed until the manager is cleared.
+    handler_node dispatcher;
+    dispatcher.kind = handler_kind::timer;
+    install_handler(m_timer_sig, std::move(dispatcher), false);
+
+    std::lock_guard<std::mutex> lock(m_handlers_mutex);
+    const handler_node* p_dispatcher = m_handlers[m_timer_sig].load(std::memory_order_relaxed);
+    if ((p_dispatcher == nullptr) || (p_dispatcher->kind != handler_kind::timer)) {
+        return invalid_timer;
+    }
+
+    std::size_t slot = 0;
+    for (; slot < max_timers; ++slot) {
+        const handler_node* p_timer = m_timer_handlers[slot].load(std::memory_order_relaxed);
+        if ((p_timer != nullptr) && ! m_is_periodic[slot] && m_is_fired[slot].load(std::memory_order_acquire)) {
+            release_timer(slot);
+            p_timer = nullptr;
+        }
+        if (p_timer == nullptr) {
+            break;
+        }
+    }
+    if (slot == max_timers) {
+        return invalid_timer;
+    }
+
+    // The identifier fits into 'int', the serial distinguishes the timers
+    // sharing the slot.
+    m_timer_serial = (m_timer_serial + 1) % (std::uint32_t(1) << 24);
+    const timer_id_t id = static_cast<timer_id_t>(m_timer_serial * max_timers + slot + 1);
+    if (! details::create_timer(m_timer_sig, id, m_timer_handles[slot])) {
+        return invalid_timer;
+    }
+    node.id = id;
+    m_is_periodic[slot] = (period.count() != 0);
+    m_is_fired[slot].store(false, std::memory_order_relaxed);
+    m_timer_handlers[slot].store(new handler_node(std::move(node)), std::memory_order_release);
+    if (! details::set_timer(m_timer_handles[slot], delay, period)) {
+        release_timer(slot);
+        return invalid_timer;
+    }
+    return id;
+}
+
+void manager::submit(handler_task&& task)
+{
+    // The task holds the handler until it is executed.
+    m_readers.fetch_add(1, std::memory_order_relaxed);
+    m_executor.submit(task.sig, static_cast<std::size_t>(task.p_handler->prio), std::move(task));
+}
+
+bool manager::timers_timeout(std::chrono::milliseconds& msec)
+{
+    if (m_timers.empty()) {
+        return false;
+    }
+
+    const std::uint64_t deadline = m_timers.next_deadline();
+    const std::uint64_t now = now_ms();
+    const std::chrono::milliseconds left((deadline > now) ? deadline - now : 0);
+    if (left < msec) {
+        msec = left;
+    }
+    return true;
+}
+
+bool manager::threaded_signals_processing(const std::chrono::milliseconds& msec)
 {
     if (m_p_thread) {
+        return false;
+    }
+
+    // The thread options are applied by the thread itself, the result is
+    // passed back before the processing starts.
+    std::promise<bool> is_applied;
+    std::future<bool> applied = is_applied.get_future();
+    m_p_thread.reset(new std::thread([msec, &is_applied]() -> void {
+        if (! apply_thread_options()) {
+            is_applied.set_value(false);
+            return;
+        }
+        is_applied.set_value(true);
+
+        if (msec == std::chrono::milliseconds(0)) {
+            processing();
+        } else {
+            processing_to(msec, false);
+        }
+        release_thread_options();
+    }));
+
+    if (! applied.get()) {
+        m_p_thread->join();
+        m_p_thread.reset();
+        return false;
+    }
+    return true;
+}
+
+void manager::update_sigset(details::sig_set_t& set, std::uint64_t& generation)
+{
+    const std::uint64_t current = m_generation.load(std::memory_order_acquire);
+    if (current == generation) {
         return;
     }
-    if (msec == std::chrono::milliseconds(0)) {
-        m_p_thread.reset(new std::thread(&manager::processing));
+    generation = current;
+
+    details::sig_set_t new_set;
+    if (! make_sigset(new_set)) {
+        return;
+    }
+    if (m_sig_fd.is_open()) {
+        m_sig_fd.open(new_set);
+    }
+    if (m_backend != backend::sigaction) {
+        details::block_sigset(new_set);
+    } else if (m_is_attached) {
+        details::unblock_sigset(new_set);
+    }
+    if (m_is_waiting) {
+        // Wakers may still use the wakeup signal, so it is waited for even if
+        // the signal has no handler.
+        ::sigaddset(&new_set, m_wake_sig);
+    }
+    set = new_set;
+}
+
+void manager::wait(const details::sig_set_t& set, const std::chrono::milliseconds* p_msec)
+{
+    if (m_sig_fd.is_open()) {
+        m_sig_fd.wait(m_event.fd(), p_msec);
+        m_event.reset();
+        return;
+    }
+    if (m_is_waiting) {
+        const ::timespec ts = p_msec ? to_timespec(*p_msec) : ::timespec{0, 0};
+        int sig = p_msec ? ::sigtimedwait(&set, &m_wait_infos[0], &ts) : ::sigwaitinfo(&set, &m_wait_infos[0]);
+
+        const ::timespec zero_ts = {0, 0};
+        while (sig > 0) {
+            if (! is_wake(m_wait_infos[m_wait_count]) && (++m_wait_count == batch_size)) {
+                break;
+            }
+            sig = ::sigtimedwait(&set, &m_wait_infos[m_wait_count], &zero_ts);
+        }
+        return;
+    }
+
+    details::unblock_sigset(set);
+    if (p_msec) {
+        m_sem.timed_wait(*p_msec);
     } else {
-        m_p_thread.reset(new std::thread(&manager::processing_to, std::cref(msec), false));
+        m_sem.wait();
+    }
+    details::block_sigset(set);
+}
+
+void manager::wake_waiter()
+{
+    // The waker is counted while it uses the waiting thread, so the thread
+    // does not finish the processing until the wakeup signal is queued.
+    const int saved_errno = errno;
+    m_wakes.fetch_add(1);
+    if (m_is_waiting && ! ::pthread_equal(m_wait_thread, ::pthread_self())) {
+        ::sigval value;
+        value.sival_ptr = &m_wakes;
+        ::pthread_sigqueue(m_wait_thread, m_wake_sig, value);
     }
+    m_wakes.fetch_sub(1);
+    errno = saved_errno;
 }
 
 } // namespace signals
 } // namespace wstux
-
@@ -0,0 +1,306 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2026 Chistyakov Alexander.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+extern "C" {
+    #include <dlfcn.h>
+    #include <execinfo.h>
+}
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cxxabi.h>
+#include <map>
+
+#include "signals/profiler.h"
+#include "signals/details/utils.h"
+
+namespace wstux {
+namespace signals {
+namespace {
+
+constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+/// \brief  Number of the captured frames of the signal handler and the signal
+///         trampoline.
+constexpr std::size_t skipped_frames = 2;
+
+std::string frame_name(void* p_frame)
+{
+    ::Dl_info info;
+    std::memset(&info, 0, sizeof(info));
+    if ((::dladdr(p_frame, &info) != 0) && (info.dli_sname != nullptr)) {
+        int status = 0;
+        char* p_name = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+        const std::string name = ((status == 0) && (p_name != nullptr)) ? p_name : info.dli_sname;
+        std::free(p_name);
+        return name;
+    }
+
+    char buf[64];
+    if (info.dli_fname != nullptr) {
+        const char* p_file = std::strrchr(info.dli_fname, '/');
+        const std::uintptr_t offset = reinterpret_cast<std::uintptr_t>(p_frame)
+                                    - reinterpret_cast<std::uintptr_t>(info.dli_fbase);
+        std::snprintf(buf, sizeof(buf), "+0x%zx", static_cast<std::size_t>(offset));
+        return std::string((p_file != nullptr) ? p_file + 1 : info.dli_fname) + buf;
+    }
+    std::snprintf(buf, sizeof(buf), "0x%zx", static_cast<std::size_t>(reinterpret_cast<std::uintptr_t>(p_frame)));
+    return buf;
+}
+
+} // <anonymous> namespace
+
+std::atomic_bool profiler::m_is_running = {false};
+sig_num_t profiler::m_sig = 0;
+std::chrono::nanoseconds profiler::m_period = std::chrono::nanoseconds(0);
+std::size_t profiler::m_capacity = 0;
+manager::timer_id_t profiler::m_timer_id = manager::invalid_timer;
+std::mutex profiler::m_mutex;
+std::atomic<::pid_t> profiler::m_owners[profiler::max_threads];
+std::atomic<profiler::ring*> profiler::m_rings[profiler::max_threads];
+std::unordered_map<std::vector<void*>, std::uint64_t, profiler::stack_hash> profiler::m_stacks;
+std::uint64_t profiler::m_samples = 0;
+std::uint64_t profiler::m_dropped = 0;
+thread_local std::size_t profiler::m_slot = npos;
+thread_local profiler::ring* profiler::m_p_ring = nullptr;
+thread_local ::timer_t profiler::m_timer;
+
+std::size_t profiler::stack_hash::operator()(const std::vector<void*>& stack) const
+{
+    std::size_t hash = stack.size();
+    for (void* p_frame : stack) {
+        hash ^= std::hash<void*>()(p_frame) + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+    }
+    return hash;
+}
+
+void profiler::aggregate()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (std::size_t slot = 0; slot < max_threads; ++slot) {
+        ring* p_ring = m_rings[slot].load(std::memory_order_acquire);
+        if (p_ring != nullptr) {
+            drain(*p_ring);
+        }
+    }
+}
+
+bool profiler::attach()
+{
+    if (! m_is_running.load(std::memory_order_acquire) || (m_slot != npos)) {
+        return false;
+    }
+
+    // The slot of a thread exiting without 'detach' is released at its exit.
+    struct exit_guard
+    {
+        ~exit_guard() { detach(); }
+    };
+    static thread_local exit_guard guard;
+
+    const ::pid_t tid = details::thread_id();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::size_t slot = 0;
+    for (; slot < max_threads; ++slot) {
+        ::pid_t free_tid = 0;
+        if (m_owners[slot].compare_exchange_strong(free_tid, tid, std::memory_order_acq_rel)) {
+            break;
+        }
+    }
+    if (slot == max_threads) {
+        return false;
+    }
+
+    // The ring is allocated here, the signal handler only fills it.
+    ring* p_ring = m_rings[slot].load(std::memory_order_relaxed);
+    if ((p_ring == nullptr) || (p_ring->samples.size() != m_capacity)) {
+        if (p_ring != nullptr) {
+            drain(*p_ring);
+            delete p_ring;
+        }
+        p_ring = new ring(m_capacity);
+        m_rings[slot].store(p_ring, std::memory_order_release);
+    }
+
+    if (! details::create_thread_timer(CLOCK_THREAD_CPUTIME_ID, m_sig, tid, m_timer)) {
+        m_owners[slot].store(0, std::memory_order_release);
+        return false;
+    }
+    m_slot = slot;
+    m_p_ring = p_ring;
+    details::unblock_signal(m_sig);
+    if (! details::set_timer(m_timer, m_period, m_period)) {
+        details::delete_timer(m_timer);
+        m_p_ring = nullptr;
+        m_slot = npos;
+        m_owners[slot].store(0, std::memory_order_release);
+        return false;
+    }
+    return true;
+}
+
+void profiler::detach()
+{
+    if (m_slot == npos) {
+        return;
+    }
+
+    // A sample generated before the timer deletion stays pending until the
+    // signal is unblocked by the next 'attach'.
+    details::delete_timer(m_timer);
+    details::block_signal(m_sig);
+    m_p_ring = nullptr;
+    m_owners[m_slot].store(0, std::memory_order_release);
+    m_slot = npos;
+}
+
+void profiler::drain(ring& r)
+{
+    const std::size_t capacity = r.samples.size();
+    std::size_t tail = r.tail.load(std::memory_order_relaxed);
+    const std::size_t head = r.head.load(std::memory_order_acquire);
+    std::vector<void*> stack;
+    for (; tail != head; ++tail) {
+        const sample& s = r.samples[tail % capacity];
+        if (s.depth > skipped_frames) {
+            stack.assign(s.frames + skipped_frames, s.frames + s.depth);
+            ++m_stacks[stack];
+        }
+        ++m_samples;
+    }
+    r.tail.store(tail, std::memory_order_release);
+    m_dropped += r.dropped.exchange(0, std::memory_order_relaxed);
+}
+
+std::uint64_t profiler::dropped()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_dropped;
+}
+
+std::string profiler::folded()
+{
+    // Stacks of different addresses within the same functions are merged.
+    std::map<std::string, std::uint64_t> lines;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const auto& stack : m_stacks) {
+            std::string line;
+            for (std::size_t i = stack.first.size(); i-- > 0;) {
+                line += frame_name(stack.first[i]);
+                if (i != 0) {
+                    line += ';';
+                }
+            }
+            lines[line] += stack.second;
+        }
+    }
+
+    std::string result;
+    for (const auto& line : lines) {
+        result += line.first;
+        result += ' ';
+        result += std::to_string(line.second);
+        result += '\n';
+    }
+    return result;
+}
+
+void profiler::on_signal_fn(sig_num_t /*sig_num*/, sig_info_t* /*sig_info*/, void*)
+{
+    ring* p_ring = m_p_ring;
+    if ((p_ring == nullptr) || ! m_is_running.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    const int saved_errno = errno;
+    const std::size_t head = p_ring->head.load(std::memory_order_relaxed);
+    if (head - p_ring->tail.load(std::memory_order_acquire) == p_ring->samples.size()) {
+        p_ring->dropped.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        sample& s = p_ring->samples[head % p_ring->samples.size()];
+        s.depth = static_cast<std::size_t>(::backtrace(s.frames, static_cast<int>(max_depth)));
+        p_ring->head.store(head + 1, std::memory_order_release);
+    }
+    errno = saved_errno;
+}
+
+void profiler::reset()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stacks.clear();
+    m_samples = 0;
+    m_dropped = 0;
+}
+
+std::uint64_t profiler::samples()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_samples;
+}
+
+bool profiler::start(manager& sm, const options& opts)
+{
+    if (m_is_running.load(std::memory_order_acquire) || (opts.frequency == 0) || (opts.ring_capacity == 0)
+        || (opts.aggregation_period.count() <= 0)) {
+        return false;
+    }
+
+    // The first call loads the unwinder, which is not async-signal-safe.
+    void* frames[max_depth];
+    ::backtrace(frames, static_cast<int>(max_depth));
+
+    if (! details::register_signal_handler(opts.signal, &on_signal_fn)) {
+        return false;
+    }
+    m_timer_id = sm.set_timer(opts.aggregation_period, []() -> void { aggregate(); }, opts.aggregation_period);
+    if (m_timer_id == manager::invalid_timer) {
+        details::unregister_signal_handler(opts.signal);
+        return false;
+    }
+
+    m_sig = opts.signal;
+    m_period = std::chrono::nanoseconds(1000000000 / opts.frequency);
+    m_capacity = opts.ring_capacity;
+    m_is_running.store(true, std::memory_order_release);
+    return true;
+}
+
+void profiler::stop(manager& sm)
+{
+    if (! m_is_running.exchange(false, std::memory_order_acq_rel)) {
+        return;
+    }
+
+    // The signal handler is left installed, so the samples of the threads
+    // still attached do not trigger the default action.
+    sm.cancel_timer(m_timer_id);
+    m_timer_id = manager::invalid_timer;
+    aggregate();
+}
+
+} // namespace signals
+} // namespace wstux
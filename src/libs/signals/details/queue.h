@@ -29,54 +29,227 @@
     #include <boost/lockfree/queue.hpp>
     #include <boost/lockfree/policies.hpp>
 #else
-    #include <mutex>
-    #include <queue>
+    #include <type_traits>
 #endif
 
+#include <atomic>
+#include <cstddef>
+
 namespace wstux {
 namespace signals {
 namespace details {
 
 #if ! defined(SIGNALS_MANAGER_USE_BOOST_LOCKFREE)
 
+/**
+ *  \brief  Bounded lock-free multi-producer queue.
+ *
+ *  The queue is a ring of cells, each cell is guarded by a sequence number
+ *  (D. Vyukov's bounded queue). Producers claim a cell with a CAS on the head
+ *  position and publish it by storing the sequence number. A producer never
+ *  waits for other producers or for the consumer, so push does not allocate,
+ *  does not lock and is async-signal-safe. If a producer is interrupted
+ *  between claiming and publishing a cell, the consumer sees the queue as
+ *  empty up to that cell until the producer resumes.
+ *
+ *  Consumers claim cells with a CAS on the tail position, so a producer is
+ *  allowed to pop the oldest value to make room for a new one.
+ *
+ *  N is the maximum capacity of the queue, the actual capacity can be reduced
+ *  with the 'reset' function.
+ */
 template<typename T, std::size_t N>
 class queue final
 {
+    static_assert(N > 1, "Queue capacity must be greater than one");
+    static_assert(std::is_trivially_copyable<T>::value, "Queue value must be trivially copyable");
+    static_assert(std::atomic<std::size_t>::is_always_lock_free, "Queue requires lock-free atomics");
+
 public:
+    queue() { reset(N); }
+
+    std::size_t capacity() const { return m_capacity; }
+
+    static constexpr std::size_t max_capacity() { return N; }
+
     bool empty() const
     {
-        std::unique_lock<std::mutex> lock(m_mutex);
-        return m_queue.empty();
+        const std::size_t pos = m_tail.load(std::memory_order_relaxed);
+        const cell& c = m_cells[pos % m_capacity];
+        return (c.seq.load(std::memory_order_acquire) != pos + 1);
+    }
+
+    bool pop(T& ret) { return (pop_bulk(&ret, 1) == 1); }
+
+    /// \brief  Pops up to 'count' values from the queue.
+    /// \details All ready cells are found by relaxed loads and claimed with
+    ///         the single CAS, then they are acquired with the single fence and
+    ///         released with the single fence.
+    /// \param  p_values - buffer for the values.
+    /// \param  count - buffer size.
+    /// \return Number of values popped.
+    /// \note   The function is async-signal-safe.
+    std::size_t pop_bulk(T* p_values, std::size_t count)
+    {
+        std::size_t pos = m_tail.load(std::memory_order_relaxed);
+        std::size_t ready;
+        for (;;) {
+            ready = 0;
+            while ((ready < count) && (ready < m_capacity)) {
+                const std::size_t cur = pos + ready;
+                if (m_cells[cur % m_capacity].seq.load(std::memory_order_relaxed) != cur + 1) {
+                    break;
+                }
+                ++ready;
+            }
+            if (ready == 0) {
+                return 0;
+            }
+            if (m_tail.compare_exchange_weak(pos, pos + ready, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        for (std::size_t i = 0; i < ready; ++i) {
+            p_values[i] = m_cells[(pos + i) % m_capacity].value;
+        }
+        std::atomic_thread_fence(std::memory_order_release);
+        for (std::size_t i = 0; i < ready; ++i) {
+            const std::size_t cur = pos + i;
+            m_cells[cur % m_capacity].seq.store(cur + m_capacity, std::memory_order_relaxed);
+        }
+        return ready;
     }
 
-    void pop(T& ret)
+    bool push(const T& value) { return try_push(value); }
+
+    /// \brief  Clears the queue and changes its capacity.
+    /// \param  capacity - new capacity, must be in range [2, N].
+    /// \return False if the capacity is out of range.
+    /// \warning The queue must not be used concurrently.
+    bool reset(std::size_t capacity)
     {
-        std::unique_lock<std::mutex> lock(m_mutex);
-        ret = m_queue.front();
-        m_queue.pop();
+        if ((capacity < 2) || (capacity > N)) {
+            return false;
+        }
+
+        m_capacity = capacity;
+        for (std::size_t i = 0; i < m_capacity; ++i) {
+            m_cells[i].seq.store(i, std::memory_order_relaxed);
+        }
+        m_head.store(0, std::memory_order_relaxed);
+        m_tail.store(0, std::memory_order_release);
+        return true;
     }
 
-    void push(const T& value)
+    /// \brief  Pushes the value to the queue if it is not full.
+    /// \note   The function is async-signal-safe.
+    bool try_push(const T& value)
     {
-        std::unique_lock<std::mutex> lock(m_mutex);
-        m_queue.push(value);
+        std::size_t pos = m_head.load(std::memory_order_relaxed);
+        cell* p_cell;
+        for (;;) {
+            p_cell = &m_cells[pos % m_capacity];
+            const std::size_t seq = p_cell->seq.load(std::memory_order_acquire);
+            const std::ptrdiff_t dif = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+            if (dif == 0) {
+                if (m_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (dif < 0) {
+                return false;
+            } else {
+                pos = m_head.load(std::memory_order_relaxed);
+            }
+        }
+
+        p_cell->value = value;
+        p_cell->seq.store(pos + 1, std::memory_order_release);
+        return true;
     }
 
 private:
-    mutable std::mutex m_mutex;
-    std::queue<T> m_queue;
-};
+    queue(const queue&);
+    queue& operator=(const queue&);
 
-template<typename T, std::size_t N>
-using signals_queue_t = ::wstux::signals::details::queue<T, N>;
+private:
+    struct cell
+    {
+        std::atomic<std::size_t> seq;
+        T value;
+    };
+
+private:
+    std::size_t m_capacity = N;
+    alignas(64) std::atomic<std::size_t> m_head = {0};
+    alignas(64) std::atomic<std::size_t> m_tail = {0};
+    alignas(64) cell m_cells[N];
+};
 
 #else
 
 template<typename T, std::size_t N>
-using signals_queue_t = boost::lockfree::queue<T, boost::lockfree::fixed_sized<true>, boost::lockfree::capacity<N>>;
+class queue final
+{
+public:
+    std::size_t capacity() const { return m_capacity; }
+
+    static constexpr std::size_t max_capacity() { return N; }
+
+    bool empty() const { return m_queue.empty(); }
+
+    bool pop(T& ret) { return (pop_bulk(&ret, 1) == 1); }
+
+    std::size_t pop_bulk(T* p_values, std::size_t count)
+    {
+        std::size_t popped = 0;
+        while ((popped < count) && m_queue.pop(p_values[popped])) {
+            ++popped;
+        }
+        m_size.fetch_sub(popped, std::memory_order_relaxed);
+        return popped;
+    }
+
+    bool push(const T& value) { return try_push(value); }
+
+    bool reset(std::size_t capacity)
+    {
+        if ((capacity < 2) || (capacity > N)) {
+            return false;
+        }
+
+        T value;
+        while (m_queue.pop(value)) {}
+        m_size.store(0, std::memory_order_relaxed);
+        m_capacity = capacity;
+        return true;
+    }
+
+    bool try_push(const T& value)
+    {
+        if (m_size.fetch_add(1, std::memory_order_relaxed) >= m_capacity) {
+            m_size.fetch_sub(1, std::memory_order_relaxed);
+            return false;
+        }
+        if (! m_queue.bounded_push(value)) {
+            m_size.fetch_sub(1, std::memory_order_relaxed);
+            return false;
+        }
+        return true;
+    }
+
+private:
+    std::size_t m_capacity = N;
+    std::atomic<std::size_t> m_size = {0};
+    boost::lockfree::queue<T, boost::lockfree::fixed_sized<true>, boost::lockfree::capacity<N>> m_queue;
+};
 
 #endif
 
+template<typename T, std::size_t N>
+using signals_queue_t = ::wstux::signals::details::queue<T, N>;
+
 } // namespace details
 } // namespace signals
 } // namespace wstux
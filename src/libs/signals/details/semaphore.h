@@ -21,50 +21,53 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
  * THE SOFTWARE.
  */
-
 #ifndef _LIBS_SIGNALS_SEMAPHORE_H_
 #define _LIBS_SIGNALS_SEMAPHORE_H_
 
 #ifdef __linux__
-    #include <semaphore.h>
+    #include <linux/futex.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
 #else
     #error "Unsupported platform for using semaphore"
 #endif
 
+#include <atomic>
+#include <cerrno>
 #include <chrono>
+#include <cstdint>
+#include <ctime>
 
 namespace wstux {
 namespace signals {
 namespace details {
 
+/**
+ *  \brief  Process-local counting semaphore on a futex word.
+ *
+ *  The waiter spins for a while before parking in the kernel, the timed wait
+ *  uses an absolute CLOCK_MONOTONIC deadline, so it neither depends on the
+ *  system time changes nor wakes up early. The number of parked waiters is
+ *  tracked, so 'post' does not make a syscall when nobody is waiting.
+ */
 class semaphore final
 {
 public:
     /// \brief  Creates a semaphore with zero count.
-    semaphore()
-    {
-        constexpr unsigned int count = 0;
-#ifdef __linux__
-        ::sem_init(&m_sem, 1, count);
-#endif
-    }
-
-    /// \brief  Destroys the semaphore.
-    ~semaphore()
-    {
-#ifdef __linux__
-        ::sem_destroy(&m_sem);
-#endif
-    }
+    semaphore() = default;
 
     /// \brief  Increments the semaphore count. If there are processes/threads
     ///         blocked waiting for the semaphore, then one of these processes
     ///         will return successfully from its wait function.
+    ///         The function is async-signal-safe.
     inline void post()
     {
-#ifdef __linux__
-        ::sem_post(&m_sem);
-#endif
+        m_count.fetch_add(1, std::memory_order_seq_cst);
+        if (m_waiters.load(std::memory_order_seq_cst) != 0) {
+            const int saved_errno = errno;
+            futex_wake();
+            errno = saved_errno;
+        }
     }
 
     /// \brief  Decrements the semaphore if the semaphore's value is greater than
@@ -75,17 +78,29 @@ public:
     ///         false. If the semaphore is posted the function returns true.
     inline bool timed_wait(const std::chrono::milliseconds& msec)
     {
-#ifdef __linux__
+        ::timespec deadline;
+        ::clock_gettime(CLOCK_MONOTONIC, &deadline);
         const long ms = msec.count();
-        const ::timespec ts{ms / 1000, (ms % 1000) * 1000000};
-        const int rc = ::sem_timedwait(&m_sem, &ts);
-        if (rc == 0) {
-            return true;
+        deadline.tv_sec += ms / 1000;
+        deadline.tv_nsec += (ms % 1000) * 1000000;
+        if (deadline.tv_nsec >= 1000000000) {
+            deadline.tv_sec += 1;
+            deadline.tv_nsec -= 1000000000;
         }
-        if (rc > 0) {
-            errno = rc; // Buggy glibc, copy the returned error code to errno.
+        return wait_until(&deadline);
+    }
+
+    /// \brief  Decrements the semaphore if the semaphore's value is greater
+    ///         than zero.
+    /// \return True if the semaphore has been decremented.
+    inline bool try_wait()
+    {
+        std::uint32_t count = m_count.load(std::memory_order_relaxed);
+        while (count != 0) {
+            if (m_count.compare_exchange_weak(count, count - 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+                return true;
+            }
         }
-#endif
         return false;
     }
 
@@ -94,22 +109,64 @@ public:
     ///         decrement the counter.
     inline void wait()
     {
-#ifdef __linux__
-        ::sem_wait(&m_sem);
-#endif
+        wait_until(nullptr);
     }
 
 private:
     semaphore(const semaphore&);
     semaphore& operator=(const semaphore&);
 
-private:
-#ifdef __linux__
-        using semaphore_t = ::sem_t;
+    static inline void cpu_relax()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__)
+        asm volatile("yield" ::: "memory");
 #endif
+    }
+
+    /// \brief  Parks the thread while the semaphore count is zero.
+    /// \return False if the deadline has expired.
+    inline bool futex_wait(const ::timespec* p_deadline)
+    {
+        const long rc = ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&m_count),
+                                  FUTEX_WAIT_BITSET | FUTEX_PRIVATE_FLAG, 0, p_deadline,
+                                  nullptr, FUTEX_BITSET_MATCH_ANY);
+        return (rc == 0) || (errno != ETIMEDOUT);
+    }
+
+    inline void futex_wake()
+    {
+        ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&m_count), FUTEX_WAKE | FUTEX_PRIVATE_FLAG, 1);
+    }
+
+    inline bool wait_until(const ::timespec* p_deadline)
+    {
+        for (std::size_t i = 0; i < spin_count; ++i) {
+            if (try_wait()) {
+                return true;
+            }
+            cpu_relax();
+        }
+
+        while (! try_wait()) {
+            m_waiters.fetch_add(1, std::memory_order_seq_cst);
+            const bool is_posted = (m_count.load(std::memory_order_seq_cst) != 0) || futex_wait(p_deadline);
+            m_waiters.fetch_sub(1, std::memory_order_relaxed);
+            if (! is_posted) {
+                return try_wait();
+            }
+        }
+        return true;
+    }
 
 private:
-    semaphore_t m_sem;
+    static constexpr std::size_t spin_count = 128;
+
+    static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t), "Futex word must be 32 bits wide");
+
+    std::atomic<std::uint32_t> m_count = {0};
+    std::atomic<std::uint32_t> m_waiters = {0};
 };
 
 } // namespace details
@@ -117,4 +174,3 @@ private:
 } // namespace wstux
 
 #endif /* _LIBS_SIGNALS_SEMAPHORE_H_ */
-
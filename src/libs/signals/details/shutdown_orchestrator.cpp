@@ -0,0 +1,219 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2026 Chistyakov Alexander.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "signals/shutdown_orchestrator.h"
+
+namespace wstux {
+namespace signals {
+
+shutdown_orchestrator::shutdown_orchestrator(manager& sm, const options& opts)
+    : m_manager(sm)
+    , m_options(opts)
+    , m_is_installed(true)
+    , m_is_started(false)
+    , m_is_done(false)
+    , m_is_escalation_pending(false)
+{
+    for (sig_num_t sig : m_options.signals) {
+        m_is_installed = m_manager.set_handler(sig, [this](sig_num_t, std::size_t count) -> void {
+            on_signal(count);
+        })
+            && m_is_installed;
+    }
+}
+
+shutdown_orchestrator::~shutdown_orchestrator()
+{
+    for (sig_num_t sig : m_options.signals) {
+        m_manager.remove_handler(sig);
+    }
+    if (is_started()) {
+        wait();
+    }
+}
+
+bool shutdown_orchestrator::add_hook(const std::string& name, shutdown_hook_fn_t hook)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = std::find_if(m_phases.begin(), m_phases.end(), [&name](const phase& p) -> bool {
+        return p.name == name;
+    });
+    if (m_is_started || (it == m_phases.end()) || ! hook) {
+        return false;
+    }
+    it->hooks.emplace_back(std::move(hook));
+    return true;
+}
+
+bool shutdown_orchestrator::add_phase(const std::string& name, const std::chrono::milliseconds& deadline)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const bool is_exist = std::any_of(m_phases.begin(), m_phases.end(), [&name](const phase& p) -> bool {
+        return p.name == name;
+    });
+    if (m_is_started || is_exist) {
+        return false;
+    }
+    m_phases.push_back(phase{name, deadline, {}});
+    return true;
+}
+
+void shutdown_orchestrator::escalate()
+{
+    if (m_options.escalation == shutdown_escalation::force_exit) {
+        std::_Exit(m_options.exit_code);
+    }
+
+    std::shared_ptr<phase_state> p_phase;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        p_phase = m_p_phase;
+        // Between the phases the escalation is passed to the next phase.
+        m_is_escalation_pending = ! p_phase && ! m_is_done;
+    }
+    if (p_phase) {
+        std::lock_guard<std::mutex> lock(p_phase->mutex);
+        p_phase->is_escalated = true;
+        p_phase->cv.notify_all();
+    }
+}
+
+bool shutdown_orchestrator::is_done() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_is_done;
+}
+
+bool shutdown_orchestrator::is_started() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_is_started;
+}
+
+void shutdown_orchestrator::on_signal(std::size_t count)
+{
+    if (request()) {
+        --count;
+    }
+    if ((count != 0) && ! is_done()) {
+        escalate();
+    }
+}
+
+std::vector<shutdown_phase_report> shutdown_orchestrator::report() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_reports;
+}
+
+bool shutdown_orchestrator::request()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_is_started) {
+        return false;
+    }
+    m_is_started = true;
+    m_thread = std::thread(&shutdown_orchestrator::run, this);
+    return true;
+}
+
+void shutdown_orchestrator::run()
+{
+    // Phases are not changed after the start, so they are read without the lock.
+    for (const phase& p : m_phases) {
+        std::shared_ptr<phase_state> p_phase = std::make_shared<phase_state>();
+        p_phase->hooks_left = p.hooks.size();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            p_phase->is_escalated = m_is_escalation_pending;
+            m_is_escalation_pending = false;
+            m_p_phase = p_phase;
+        }
+
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (const shutdown_hook_fn_t& hook : p.hooks) {
+            std::thread([p_phase, hook]() -> void {
+                hook();
+                std::lock_guard<std::mutex> lock(p_phase->mutex);
+                --p_phase->hooks_left;
+                p_phase->cv.notify_all();
+            }).detach();
+        }
+
+        shutdown_phase_report phase_report;
+        {
+            const auto is_over = [&p_phase]() -> bool { return (p_phase->hooks_left == 0) || p_phase->is_escalated; };
+            std::unique_lock<std::mutex> lock(p_phase->mutex);
+            bool is_timed_out = false;
+            if (p.deadline.count() > 0) {
+                is_timed_out = ! p_phase->cv.wait_until(lock, start + p.deadline, is_over);
+            } else {
+                p_phase->cv.wait(lock, is_over);
+            }
+            phase_report.name = p.name;
+            phase_report.duration = std::chrono::steady_clock::now() - start;
+            phase_report.unfinished = p_phase->hooks_left;
+            phase_report.is_timed_out = is_timed_out;
+            phase_report.is_escalated = (p_phase->hooks_left != 0) && p_phase->is_escalated;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_p_phase.reset();
+        m_reports.push_back(std::move(phase_report));
+    }
+
+    if (m_options.stop_processing) {
+        m_manager.stop_processing();
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_is_done = true;
+    m_cv.notify_all();
+}
+
+void shutdown_orchestrator::wait()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cv.wait(lock, [this]() -> bool { return m_is_done; });
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+bool shutdown_orchestrator::wait(const std::chrono::milliseconds& msec)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (! m_cv.wait_for(lock, msec, [this]() -> bool { return m_is_done; })) {
+        return false;
+    }
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+    return true;
+}
+
+} // namespace signals
+} // namespace wstux
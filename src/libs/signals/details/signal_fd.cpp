@@ -0,0 +1,155 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2026 Chistyakov Alexander.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+extern "C" {
+    #include <poll.h>
+    #include <sys/signalfd.h>
+    #include <unistd.h>
+}
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+
+#include "signals/details/signal_fd.h"
+#include "signals/details/utils.h"
+
+namespace wstux {
+namespace signals {
+namespace details {
+namespace {
+
+void to_sig_info(const ::signalfd_siginfo& ssi, sig_info_t& info)
+{
+    ::memset(&info, 0, sizeof(info));
+    info.si_signo = static_cast<int>(ssi.ssi_signo);
+    info.si_errno = ssi.ssi_errno;
+    info.si_code = ssi.ssi_code;
+
+    if (info.si_code == SI_TIMER) {
+        info.si_timerid = static_cast<int>(ssi.ssi_tid);
+        info.si_overrun = static_cast<int>(ssi.ssi_overrun);
+        info.si_value.sival_ptr = reinterpret_cast<void*>(ssi.ssi_ptr);
+        return;
+    }
+    if ((info.si_code > 0) && (info.si_signo == SIGCHLD)) {
+        info.si_pid = static_cast<pid_t>(ssi.ssi_pid);
+        info.si_uid = static_cast<uid_t>(ssi.ssi_uid);
+        info.si_status = ssi.ssi_status;
+        info.si_utime = static_cast<clock_t>(ssi.ssi_utime);
+        info.si_stime = static_cast<clock_t>(ssi.ssi_stime);
+        return;
+    }
+    if ((info.si_code > 0) && (info.si_signo == SIGPOLL)) {
+        info.si_band = static_cast<long>(ssi.ssi_band);
+        info.si_fd = ssi.ssi_fd;
+        return;
+    }
+    if ((info.si_code > 0) && ((info.si_signo == SIGILL) || (info.si_signo == SIGFPE) ||
+                               (info.si_signo == SIGBUS) || (info.si_signo == SIGTRAP))) {
+        info.si_addr = reinterpret_cast<void*>(ssi.ssi_addr);
+        return;
+    }
+
+    info.si_pid = static_cast<pid_t>(ssi.ssi_pid);
+    info.si_uid = static_cast<uid_t>(ssi.ssi_uid);
+    info.si_value.sival_ptr = reinterpret_cast<void*>(ssi.ssi_ptr);
+}
+
+} // <anonymous> namespace
+
+void signal_fd::close()
+{
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+}
+
+bool signal_fd::open(const sig_set_t& set)
+{
+    const int fd = ::signalfd(m_fd, &set, SFD_NONBLOCK | SFD_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    m_fd = fd;
+    return true;
+}
+
+std::size_t signal_fd::read(sig_info_t* p_infos, std::size_t count)
+{
+    constexpr std::size_t kBatchSize = 16;
+
+    std::size_t total = 0;
+    while (total < count) {
+        ::signalfd_siginfo buf[kBatchSize];
+        const std::size_t size = std::min(count - total, kBatchSize) * sizeof(::signalfd_siginfo);
+        const ssize_t rc = ::read(m_fd, buf, size);
+        if (rc < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+
+        const std::size_t read_count = static_cast<std::size_t>(rc) / sizeof(::signalfd_siginfo);
+        for (std::size_t i = 0; i < read_count; ++i) {
+            to_sig_info(buf[i], p_infos[total + i]);
+        }
+        total += read_count;
+        if (read_count * sizeof(::signalfd_siginfo) < size) {
+            break;
+        }
+    }
+    return total;
+}
+
+bool signal_fd::wait(int wake_fd, const std::chrono::milliseconds* p_msec) const
+{
+    ::pollfd fds[2] = {{m_fd, POLLIN, 0}, {wake_fd, POLLIN, 0}};
+
+    // The timeout is recomputed from the CLOCK_MONOTONIC deadline after each
+    // interruption, so EINTR does not stretch the wait.
+    const std::uint64_t start_ms = monotonic_ns() / 1000000;
+    const std::uint64_t deadline_ms = p_msec
+        ? start_ms + std::min<std::uint64_t>(std::max<std::chrono::milliseconds::rep>(p_msec->count(), 0), INT64_MAX)
+        : 0;
+    int rc;
+    do {
+        int timeout = -1;
+        if (p_msec) {
+            const std::uint64_t now_ms = monotonic_ns() / 1000000;
+            const std::uint64_t left_ms = (deadline_ms > now_ms) ? deadline_ms - now_ms : 0;
+            timeout = static_cast<int>(std::min<std::uint64_t>(left_ms, INT_MAX));
+        }
+        rc = ::poll(fds, 2, timeout);
+    } while ((rc < 0) && (errno == EINTR));
+    return (rc > 0) && ((fds[0].revents & POLLIN) != 0);
+}
+
+} // namespace details
+} // namespace signals
+} // namespace wstux
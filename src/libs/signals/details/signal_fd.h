@@ -0,0 +1,91 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2026 Chistyakov Alexander.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef _LIBS_SIGNALS_SIGNAL_FD_H_
+#define _LIBS_SIGNALS_SIGNAL_FD_H_
+
+#include <chrono>
+#include <cstddef>
+
+#include "signals/types.h"
+#include "signals/details/utils.h"
+
+namespace wstux {
+namespace signals {
+namespace details {
+
+/**
+ *  \brief  Signal file descriptor.
+ *
+ *  Wrapper over the 'signalfd' descriptor created with the 'SFD_NONBLOCK' and
+ *  'SFD_CLOEXEC' flags. The signals of the set must be blocked in all threads,
+ *  otherwise they will be delivered in the usual way.
+ */
+class signal_fd final
+{
+public:
+    signal_fd() = default;
+
+    ~signal_fd() { close(); }
+
+    /// \brief  Closes the signal file descriptor.
+    void close();
+
+    /// \brief  Returns the file descriptor that becomes readable when one of
+    ///         the signals of the set is pending.
+    int fd() const { return m_fd; }
+
+    bool is_open() const { return (m_fd >= 0); }
+
+    /// \brief  Creates the signal file descriptor or changes the set of signals
+    ///         of the already created descriptor.
+    /// \param  set - set of signals to be accepted via the descriptor.
+    /// \return True - the descriptor has been created successfully.
+    bool open(const sig_set_t& set);
+
+    /// \brief  Reads pending signals without blocking.
+    /// \param  p_infos - buffer for information about signals.
+    /// \param  count - buffer size.
+    /// \return Number of signals read.
+    std::size_t read(sig_info_t* p_infos, std::size_t count);
+
+    /// \brief  Waits for pending signals or the wake descriptor to be readable.
+    /// \param  wake_fd - wake descriptor.
+    /// \param  p_msec - the timeout value, if nullptr - wait infinitely.
+    /// \return True if there are pending signals.
+    bool wait(int wake_fd, const std::chrono::milliseconds* p_msec = nullptr) const;
+
+private:
+    signal_fd(const signal_fd&);
+    signal_fd& operator=(const signal_fd&);
+
+private:
+    int m_fd = -1;
+};
+
+} // namespace details
+} // namespace signals
+} // namespace wstux
+
+#endif /* _LIBS_SIGNALS_SIGNAL_FD_H_ */
@@ -0,0 +1,163 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2026 Chistyakov Alexander.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <sched.h>
+
+#include "signals/thread_signals.h"
+#include "signals/details/utils.h"
+
+namespace wstux {
+namespace signals {
+namespace {
+
+constexpr std::size_t npos = static_cast<std::size_t>(-1);
+constexpr std::uint64_t senders_mask = 0xFFFFFFFFull;
+
+constexpr std::uint32_t generation_of(std::uint64_t state) { return static_cast<std::uint32_t>(state >> 32); }
+
+thread_local std::size_t tl_slot = npos;
+thread_local thread_signals::handler_fn_t tl_handler;
+
+} // <anonymous> namespace
+
+sig_num_t thread_signals::m_sig = 0;
+thread_signals::mailbox thread_signals::m_mailboxes[thread_signals::max_threads];
+
+bool thread_signals::attach(handler_fn_t handler)
+{
+    if ((m_sig == 0) || (tl_slot != npos)) {
+        return false;
+    }
+
+    const ::pid_t tid = details::thread_id();
+    for (std::size_t slot = 0; slot < max_threads; ++slot) {
+        ::pid_t free_tid = 0;
+        mailbox& box = m_mailboxes[slot];
+        if (box.tid.compare_exchange_strong(free_tid, tid, std::memory_order_acq_rel)) {
+            if (++box.generation == 0) {
+                ++box.generation;
+            }
+            box.bits.store(0, std::memory_order_relaxed);
+            box.state.store(static_cast<std::uint64_t>(box.generation) << 32, std::memory_order_release);
+            tl_slot = slot;
+            tl_handler = std::move(handler);
+            details::unblock_signal(m_sig);
+            return true;
+        }
+    }
+    return false;
+}
+
+void thread_signals::detach()
+{
+    if (tl_slot == npos) {
+        return;
+    }
+
+    // New senders are rejected once the generation is cleared, the pinning
+    // ones are waited for, so none of them sends the signal after the return.
+    mailbox& box = m_mailboxes[tl_slot];
+    box.state.fetch_and(senders_mask, std::memory_order_acq_rel);
+    while ((box.state.load(std::memory_order_acquire) & senders_mask) != 0) {
+        ::sched_yield();
+    }
+    details::block_signal(m_sig);
+    box.bits.store(0, std::memory_order_relaxed);
+    box.tid.store(0, std::memory_order_release);
+    tl_slot = npos;
+    tl_handler = nullptr;
+}
+
+std::uint32_t thread_signals::dispatch()
+{
+    if (tl_slot == npos) {
+        return 0;
+    }
+
+    const std::uint32_t bits = m_mailboxes[tl_slot].bits.exchange(0, std::memory_order_acquire);
+    if ((bits != 0) && tl_handler) {
+        tl_handler(bits);
+    }
+    return bits;
+}
+
+bool thread_signals::is_pending()
+{
+    return (tl_slot != npos) && (m_mailboxes[tl_slot].bits.load(std::memory_order_relaxed) != 0);
+}
+
+void thread_signals::reset_signal()
+{
+    if (m_sig != 0) {
+        details::unregister_signal_handler(m_sig);
+        m_sig = 0;
+    }
+}
+
+bool thread_signals::send(const thread_handle& thread, std::uint32_t bits)
+{
+    if ((bits == 0) || (thread.slot >= max_threads) || (m_sig == 0)) {
+        return false;
+    }
+
+    // The mailbox is pinned only while it belongs to the attachment of the
+    // handle, and 'detach' waits for the pinning senders, so the thread stays
+    // attached until the signal has been sent.
+    mailbox& box = m_mailboxes[thread.slot];
+    std::uint64_t state = box.state.load(std::memory_order_relaxed);
+    do {
+        if ((thread.generation == 0) || (generation_of(state) != thread.generation)) {
+            return false;
+        }
+    } while (! box.state.compare_exchange_weak(state, state + 1, std::memory_order_acquire, std::memory_order_relaxed));
+
+    // The bits are set before the signal, so the interrupted thread sees them.
+    box.bits.fetch_or(bits, std::memory_order_release);
+    const bool is_sent = details::send_thread_signal(thread.tid, m_sig);
+    box.state.fetch_sub(1, std::memory_order_release);
+    return is_sent;
+}
+
+thread_handle thread_signals::self()
+{
+    thread_handle handle;
+    if (tl_slot != npos) {
+        handle.slot = tl_slot;
+        handle.tid = m_mailboxes[tl_slot].tid.load(std::memory_order_relaxed);
+        handle.generation = m_mailboxes[tl_slot].generation;
+    }
+    return handle;
+}
+
+bool thread_signals::set_signal(sig_num_t sig)
+{
+    if (! details::register_signal_handler(sig, &on_signal_fn, false)) {
+        return false;
+    }
+    m_sig = sig;
+    return true;
+}
+
+} // namespace signals
+} // namespace wstux
@@ -0,0 +1,103 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2026 Chistyakov Alexander.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef _LIBS_SIGNALS_TIMER_FD_H_
+#define _LIBS_SIGNALS_TIMER_FD_H_
+
+#ifdef __linux__
+    #include <sys/timerfd.h>
+    #include <unistd.h>
+#else
+    #error "Unsupported platform for using timer fd"
+#endif
+
+#include <cstdint>
+#include <ctime>
+
+namespace wstux {
+namespace signals {
+namespace details {
+
+/**
+ *  \brief  Timer file descriptor.
+ *
+ *  The descriptor becomes readable when the 'CLOCK_MONOTONIC' clock reaches
+ *  the armed deadline and stays readable until the timer is armed again.
+ */
+class timer_fd final
+{
+public:
+    timer_fd() = default;
+
+    ~timer_fd() { close(); }
+
+    /// \brief  Arms the timer at the absolute deadline.
+    /// \param  deadline_ns - 'CLOCK_MONOTONIC' deadline in nanoseconds, zero
+    ///         disarms the timer.
+    /// \return True - the timer has been armed successfully.
+    inline bool arm(std::uint64_t deadline_ns)
+    {
+        ::itimerspec spec = {};
+        spec.it_value.tv_sec = static_cast<std::time_t>(deadline_ns / 1000000000);
+        spec.it_value.tv_nsec = static_cast<long>(deadline_ns % 1000000000);
+        return (::timerfd_settime(m_fd, TFD_TIMER_ABSTIME, &spec, nullptr) == 0);
+    }
+
+    /// \brief  Closes the timer file descriptor.
+    inline void close()
+    {
+        if (m_fd >= 0) {
+            ::close(m_fd);
+            m_fd = -1;
+        }
+    }
+
+    /// \brief  Returns the file descriptor that becomes readable at the
+    ///         deadline.
+    inline int fd() const { return m_fd; }
+
+    inline bool is_open() const { return (m_fd >= 0); }
+
+    /// \brief  Creates the disarmed timer file descriptor.
+    /// \return True - the descriptor has been created successfully.
+    inline bool open()
+    {
+        close();
+        m_fd = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+        return (m_fd >= 0);
+    }
+
+private:
+    timer_fd(const timer_fd&);
+    timer_fd& operator=(const timer_fd&);
+
+private:
+    int m_fd = -1;
+};
+
+} // namespace details
+} // namespace signals
+} // namespace wstux
+
+#endif /* _LIBS_SIGNALS_TIMER_FD_H_ */
@@ -0,0 +1,180 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2026 Chistyakov Alexander.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef _LIBS_SIGNALS_TIMER_WHEEL_H_
+#define _LIBS_SIGNALS_TIMER_WHEEL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace wstux {
+namespace signals {
+namespace details {
+
+/**
+ *  \brief  Hashed timer wheel of millisecond deadlines.
+ *
+ *  Timers are identified by numbers in range [0, TIds), each timer is either
+ *  scheduled once or not scheduled. A timer is linked into the slot of its
+ *  deadline tick, timers further than TSlots ticks stay in their slot until
+ *  the wheel turns to their round. Scheduling and cancelling cost O(1) and do
+ *  not allocate, expiring visits only the slots of the elapsed ticks.
+ *
+ *  The wheel is not thread-safe.
+ */
+template<std::size_t TIds, std::size_t TSlots = 256>
+class timer_wheel final
+{
+    static_assert((TSlots & (TSlots - 1)) == 0, "Number of slots must be a power of two");
+
+public:
+    static constexpr std::uint64_t never = std::numeric_limits<std::uint64_t>::max();
+
+public:
+    timer_wheel() { clear(); }
+
+    void cancel(std::size_t id)
+    {
+        if (m_deadlines[id] == never) {
+            return;
+        }
+
+        if (m_prev[id] != npos) {
+            m_next[m_prev[id]] = m_next[id];
+        } else {
+            m_heads[m_deadlines[id] & (TSlots - 1)] = m_next[id];
+        }
+        if (m_next[id] != npos) {
+            m_prev[m_next[id]] = m_prev[id];
+        }
+        m_deadlines[id] = never;
+        --m_size;
+    }
+
+    void clear()
+    {
+        for (std::size_t& head : m_heads) {
+            head = npos;
+        }
+        for (std::size_t id = 0; id < TIds; ++id) {
+            m_deadlines[id] = never;
+        }
+        m_size = 0;
+        m_current = 0;
+    }
+
+    std::uint64_t deadline(std::size_t id) const { return m_deadlines[id]; }
+
+    bool empty() const { return (m_size == 0); }
+
+    /// \brief  Removes the timers with the deadline not later than 'now' and
+    ///         calls 'func(id)' for each of them in the order of deadlines'
+    ///         ticks. The function can schedule the timers again.
+    template<typename TFunc>
+    void expire(std::uint64_t now, TFunc&& func)
+    {
+        if (m_size == 0) {
+            m_current = now;
+            return;
+        }
+        if (now < m_current) {
+            return;
+        }
+
+        std::size_t expired[TIds];
+        std::size_t count = 0;
+        const std::uint64_t ticks = now - m_current + 1;
+        const std::uint64_t last = (ticks >= TSlots) ? m_current + TSlots - 1 : now;
+        for (std::uint64_t tick = m_current; tick <= last; ++tick) {
+            std::size_t id = m_heads[tick & (TSlots - 1)];
+            while (id != npos) {
+                const std::size_t next = m_next[id];
+                if (m_deadlines[id] <= now) {
+                    cancel(id);
+                    expired[count++] = id;
+                }
+                id = next;
+            }
+        }
+        m_current = now;
+
+        for (std::size_t i = 0; i < count; ++i) {
+            func(expired[i]);
+        }
+    }
+
+    /// \brief  Returns the earliest deadline or 'never' if there are no
+    ///         scheduled timers.
+    std::uint64_t next_deadline() const
+    {
+        std::uint64_t result = never;
+        if (m_size == 0) {
+            return result;
+        }
+        for (std::size_t id = 0; id < TIds; ++id) {
+            if (m_deadlines[id] < result) {
+                result = m_deadlines[id];
+            }
+        }
+        return result;
+    }
+
+    /// \brief  Schedules the timer, the timer scheduled earlier is moved to
+    ///         the new deadline.
+    void schedule(std::size_t id, std::uint64_t deadline)
+    {
+        cancel(id);
+        if (deadline < m_current) {
+            deadline = m_current;
+        }
+
+        const std::size_t slot = deadline & (TSlots - 1);
+        m_deadlines[id] = deadline;
+        m_prev[id] = npos;
+        m_next[id] = m_heads[slot];
+        if (m_heads[slot] != npos) {
+            m_prev[m_heads[slot]] = id;
+        }
+        m_heads[slot] = id;
+        ++m_size;
+    }
+
+private:
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+private:
+    std::size_t m_heads[TSlots];
+    std::size_t m_next[TIds];
+    std::size_t m_prev[TIds];
+    std::uint64_t m_deadlines[TIds];
+    std::size_t m_size = 0;
+    std::uint64_t m_current = 0;
+};
+
+} // namespace details
+} // namespace signals
+} // namespace wstux
+
+#endif /* _LIBS_SIGNALS_TIMER_WHEEL_H_ */
@@ -24,15 +24,54 @@
 
 extern "C" {
     #include <pthread.h>
+    #include <sched.h>
+    #include <sys/mman.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
 }
 
+#include <algorithm>
 #include <cstring>
+#include <ctime>
 
 #include "signals/details/utils.h"
 
 namespace wstux {
 namespace signals {
 namespace details {
+namespace {
+
+/// \brief  Expands the memory range to the page boundaries.
+void page_align(const void*& p_addr, std::size_t& size)
+{
+    const std::uintptr_t page = static_cast<std::uintptr_t>(::sysconf(_SC_PAGESIZE));
+    const std::uintptr_t begin = reinterpret_cast<std::uintptr_t>(p_addr) & ~(page - 1);
+    const std::uintptr_t end = (reinterpret_cast<std::uintptr_t>(p_addr) + size + page - 1) & ~(page - 1);
+    p_addr = reinterpret_cast<const void*>(begin);
+    size = end - begin;
+}
+
+/// \brief  Returns the top part of the calling thread stack.
+bool thread_stack_top(std::size_t size, const void*& p_addr, std::size_t& locked_size)
+{
+    ::pthread_attr_t attr;
+    if (::pthread_getattr_np(::pthread_self(), &attr) != 0) {
+        return false;
+    }
+    void* p_stack = nullptr;
+    std::size_t stack_size = 0;
+    const bool is_ok = (::pthread_attr_getstack(&attr, &p_stack, &stack_size) == 0);
+    ::pthread_attr_destroy(&attr);
+    if (! is_ok) {
+        return false;
+    }
+
+    locked_size = (size < stack_size) ? size : stack_size;
+    p_addr = static_cast<const char*>(p_stack) + stack_size - locked_size;
+    return true;
+}
+
+} // <anonymous> namespace
 
 bool block_signal(sig_num_t sig)
 {
@@ -51,12 +90,61 @@ bool block_sigset(const sig_set_t& set)
     return (::pthread_sigmask(SIG_BLOCK, &set, nullptr) == 0);
 }
 
+bool create_timer(sig_num_t sig, std::uintptr_t value, ::timer_t& timer)
+{
+    ::sigevent event;
+    ::memset(&event, 0, sizeof(event));
+    event.sigev_notify = SIGEV_SIGNAL;
+    event.sigev_signo = sig;
+    event.sigev_value.sival_ptr = reinterpret_cast<void*>(value);
+    return (::timer_create(CLOCK_MONOTONIC, &event, &timer) == 0);
+}
+
+bool create_thread_timer(::clockid_t clock, sig_num_t sig, ::pid_t tid, ::timer_t& timer)
+{
+    ::sigevent event;
+    ::memset(&event, 0, sizeof(event));
+    event.sigev_notify = SIGEV_THREAD_ID;
+    event.sigev_signo = sig;
+#if defined(sigev_notify_thread_id)
+    event.sigev_notify_thread_id = tid;
+#else
+    event._sigev_un._tid = tid;
+#endif
+    return (::timer_create(clock, &event, &timer) == 0);
+}
+
+bool delete_timer(::timer_t timer)
+{
+    return (::timer_delete(timer) == 0);
+}
+
 bool is_safe_signal(sig_num_t sig)
 {
     return (sig != SIGSEGV) && (sig != SIGKILL) && (sig != SIGSTOP) && (sig != SIGCONT);
 }
 
-bool register_signal_handler(sig_num_t sig, sig_action_fn_t on_signal_fn)
+bool lock_memory(const void* p_addr, std::size_t size)
+{
+    page_align(p_addr, size);
+    return (::mlock(p_addr, size) == 0);
+}
+
+bool lock_thread_stack(std::size_t size)
+{
+    const void* p_addr = nullptr;
+    std::size_t locked_size = 0;
+    return thread_stack_top(size, p_addr, locked_size) && lock_memory(p_addr, locked_size);
+}
+
+std::uint64_t monotonic_ns()
+{
+    ::timespec ts;
+    ::clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<std::uint64_t>(ts.tv_sec) * 1000000000 + static_cast<std::uint64_t>(ts.tv_nsec);
+}
+
+bool register_signal_handler(sig_num_t sig, sig_action_fn_t on_signal_fn, bool is_restart)
 {
     if (! is_safe_signal(sig)) {
         return false;
@@ -64,11 +152,72 @@ bool register_signal_handler(sig_num_t sig, sig_action_fn_t on_signal_fn)
 
     struct ::sigaction sa;
     ::memset(&sa, 0, sizeof(sa));
-    sa.sa_flags = SA_RESTART | SA_SIGINFO ;
+    sa.sa_flags = is_restart ? (SA_RESTART | SA_SIGINFO) : SA_SIGINFO;
     sa.sa_sigaction = on_signal_fn;
     return (::sigaction(sig, &sa, 0) == 0);
 }
 
+bool send_thread_signal(::pid_t tid, sig_num_t sig)
+{
+    return (::syscall(SYS_tgkill, ::getpid(), tid, sig) == 0);
+}
+
+bool set_thread_affinity(const std::vector<int>& cpus)
+{
+    ::cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus) {
+        if ((cpu < 0) || (cpu >= CPU_SETSIZE)) {
+            return false;
+        }
+        CPU_SET(cpu, &set);
+    }
+    return (::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set) == 0);
+}
+
+bool set_thread_name(const std::string& name)
+{
+    return (::pthread_setname_np(::pthread_self(), name.substr(0, 15).c_str()) == 0);
+}
+
+bool set_thread_scheduling(sched_policy policy, int priority)
+{
+    int sched = SCHED_OTHER;
+    switch (policy) {
+    case sched_policy::other:
+        sched = SCHED_OTHER;
+        break;
+    case sched_policy::fifo:
+        sched = SCHED_FIFO;
+        break;
+    case sched_policy::round_robin:
+        sched = SCHED_RR;
+        break;
+    }
+
+    ::sched_param param;
+    ::memset(&param, 0, sizeof(param));
+    param.sched_priority = priority;
+    return (::pthread_setschedparam(::pthread_self(), sched, &param) == 0);
+}
+
+bool set_timer(::timer_t timer, const std::chrono::nanoseconds& delay, const std::chrono::nanoseconds& period)
+{
+    // Zero delay disarms the timer, so it is rounded up to one nanosecond.
+    const std::chrono::nanoseconds::rep delay_ns = std::max<std::chrono::nanoseconds::rep>(delay.count(), 1);
+    ::itimerspec spec;
+    spec.it_value.tv_sec = delay_ns / 1000000000;
+    spec.it_value.tv_nsec = delay_ns % 1000000000;
+    spec.it_interval.tv_sec = period.count() / 1000000000;
+    spec.it_interval.tv_nsec = period.count() % 1000000000;
+    return (::timer_settime(timer, 0, &spec, nullptr) == 0);
+}
+
+::pid_t thread_id()
+{
+    return static_cast<::pid_t>(::syscall(SYS_gettid));
+}
+
 bool unblock_signal(sig_num_t sig)
 {
     if (! is_safe_signal(sig)) {
@@ -86,6 +235,19 @@ bool unblock_sigset(const sig_set_t& set)
     return (::pthread_sigmask(SIG_UNBLOCK, &set, nullptr) == 0);
 }
 
+bool unlock_memory(const void* p_addr, std::size_t size)
+{
+    page_align(p_addr, size);
+    return (::munlock(p_addr, size) == 0);
+}
+
+bool unlock_thread_stack(std::size_t size)
+{
+    const void* p_addr = nullptr;
+    std::size_t locked_size = 0;
+    return thread_stack_top(size, p_addr, locked_size) && unlock_memory(p_addr, locked_size);
+}
+
 bool unregister_signal_handler(sig_num_t sig)
 {
     if (! is_safe_signal(sig)) {
@@ -25,8 +25,15 @@
 #ifndef _LIBS_SIGNALS_UTILS_H_
 #define _LIBS_SIGNALS_UTILS_H_
 
+#include <chrono>
 #include <csignal>
-//#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include <vector>
+
+#include <sys/types.h>
 
 #include "signals/types.h"
 
@@ -41,14 +48,65 @@ bool block_signal(sig_num_t num);
 
 bool block_sigset(const sig_set_t& set);
 
+/// \brief  Creates the CLOCK_MONOTONIC POSIX timer delivering the signal with
+///         the value in 'si_value.sival_ptr'.
+bool create_timer(sig_num_t sig, std::uintptr_t value, ::timer_t& timer);
+
+/// \brief  Creates the POSIX timer of the clock delivering the signal to the
+///         thread.
+bool create_thread_timer(::clockid_t clock, sig_num_t sig, ::pid_t tid, ::timer_t& timer);
+
+bool delete_timer(::timer_t timer);
+
 bool is_safe_signal(sig_num_t sig);
 
-bool register_signal_handler(sig_num_t sig, sig_action_fn_t on_signal_fn);
+/// \brief  Locks the pages of the memory range in RAM, the pages are faulted
+///         in by the call.
+bool lock_memory(const void* p_addr, std::size_t size);
+
+/// \brief  Pre-faults and locks in RAM the top of the calling thread stack.
+/// \param  size - size of the stack part to be locked.
+bool lock_thread_stack(std::size_t size);
+
+/// \brief  Returns CLOCK_MONOTONIC time in nanoseconds.
+/// \note   The function is async-signal-safe.
+std::uint64_t monotonic_ns();
+
+/// \brief  Sets the signal handler.
+/// \param  is_restart - restart the system calls interrupted by the signal,
+///         if false - the calls fail with EINTR.
+bool register_signal_handler(sig_num_t sig, sig_action_fn_t on_signal_fn, bool is_restart = true);
+
+/// \brief  Sends the signal to the thread of the calling process.
+/// \note   The function is async-signal-safe.
+bool send_thread_signal(::pid_t tid, sig_num_t sig);
+
+/// \brief  Pins the calling thread to the CPUs.
+bool set_thread_affinity(const std::vector<int>& cpus);
+
+/// \brief  Sets the calling thread name, the name is truncated to 15
+///         characters.
+bool set_thread_name(const std::string& name);
+
+/// \brief  Sets the scheduling policy and the static priority of the calling
+///         thread.
+bool set_thread_scheduling(sched_policy policy, int priority);
+
+/// \brief  Arms the timer, the timer with zero period fires once.
+bool set_timer(::timer_t timer, const std::chrono::nanoseconds& delay, const std::chrono::nanoseconds& period);
+
+/// \brief  Returns the kernel id of the calling thread.
+/// \note   The function is async-signal-safe.
+::pid_t thread_id();
 
 bool unblock_signal(sig_num_t sig);
 
 bool unblock_sigset(const sig_set_t& set);
 
+bool unlock_memory(const void* p_addr, std::size_t size);
+
+bool unlock_thread_stack(std::size_t size);
+
 bool unregister_signal_handler(sig_num_t sig);
 
 } // namespace details
@@ -27,14 +27,35 @@
 
 #include <atomic>
 #include <chrono>
+#include <cstdint>
+#include <limits>
 #include <memory>
 #include <mutex>
+#include <string>
 #include <thread>
-#include <unordered_map>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
+#include <pthread.h>
+#include <unistd.h>
+
+#include "signals/stats.h"
 #include "signals/types.h"
+#include "signals/details/epoll_fd.h"
+#include "signals/details/event_fd.h"
+#include "signals/details/executor.h"
+#include "signals/details/function.h"
 #include "signals/details/queue.h"
 #include "signals/details/semaphore.h"
+#include "signals/details/signal_fd.h"
+#include "signals/details/timer_fd.h"
+#include "signals/details/timer_wheel.h"
+#include "signals/details/utils.h"
+
+#if ! defined(SIGNALS_MANAGER_QUEUE_CAPACITY)
+    #define SIGNALS_MANAGER_QUEUE_CAPACITY 31
+#endif
 
 namespace wstux {
 namespace signals {
@@ -51,8 +72,12 @@ namespace signals {
  *  a default handler is registered.
  *
  *  Signal processing occurs in a separate thread, which personally removes
- *  locks for registered signals. Handlers cannot be added or removed while the
- *  signal processing thread is running.
+ *  locks for registered signals. Handlers can be added, changed or removed
+ *  while the signal processing thread is running: each handler is published
+ *  via an atomic pointer, the dispatching thread reads it without locks, and
+ *  the replaced handler is destroyed only when no dispatch cycle or handler
+ *  call that could use it is running. The change takes effect on the next
+ *  dispatch.
  *
  *  When the manager is destroyed, the installed signal blocks are unblocked,
  *  and all handlers are deregistered.
@@ -80,49 +105,340 @@ namespace signals {
  *  thread as well. To protect against such situations, a lock-free signal queue
  *  is used, and the signal processing thread will also see the presence of a
  *  new signal via a semaphore.
+ *
+ *  If the manager is created with the 'backend::signalfd' delivery backend,
+ *  registered signals stay blocked in the processing thread too and are read
+ *  in batches from the 'signalfd' descriptor, so no code runs in the signal
+ *  context. The 'sigaction' handler is still registered for threads that have
+ *  unblocked the signals, such signals are passed through the queue.
+ *
+ *  If the manager is created with the 'backend::sigwait' delivery backend,
+ *  registered signals stay blocked in the processing thread as well and are
+ *  pulled synchronously by 'sigwaitinfo'/'sigtimedwait', so neither the signal
+ *  mask is toggled nor the queue and the semaphore are used. The processing
+ *  thread is woken up for the stop by a signal directed to it.
+ *
+ *  Signals can also be handled in an external reactor: 'open_notify_fd'
+ *  returns a descriptor that becomes readable when signals are pending, and
+ *  'dispatch_pending' calls the handlers on the caller's thread without
+ *  blocking. No processing thread is needed in this case.
+ *
+ *  By default, handlers are called one after another by the processing thread.
+ *  If the manager is created with worker threads, the processing thread hands
+ *  the drained signals to the pool of workers: the handler calls for the same
+ *  signal stay ordered and serial, handlers of different signals run in
+ *  parallel, and signals of a higher priority are handled first.
+ *
+ *  If any handler has a priority other than 'priority::normal', the records
+ *  drained in one wakeup are dispatched from the highest priority to the
+ *  lowest one, keeping their order within a signal, so a critical signal is
+ *  not delayed by a burst of queued ones.
+ *
+ *  The queue capacity is limited at build time by the
+ *  'SIGNALS_MANAGER_QUEUE_CAPACITY' definition and can be reduced when the
+ *  manager is created. Signals that do not fit into the queue are handled
+ *  according to the overflow policy and are counted per signal number.
+ *
+ *  Handlers are stored in a flat table indexed by the signal number, so
+ *  dispatching a signal costs no hashing, no heap allocation and a single
+ *  indirect call.
+ *
+ *  Standard signals are coalesced by the kernel anyway, so a handler of the
+ *  'sig_coalesced_fn_t' signature can be set for them. Such signals bypass the
+ *  queue: the signal handler sets a bit in the pending mask and increments
+ *  the signal counter, and the processing thread calls the handler once per
+ *  wakeup with the number of signals received.
+ *
+ *  A batch handler set by 'set_batch_handler' is called once per wakeup with
+ *  all the records of the signal drained from the queue, which is useful for
+ *  real-time signals carrying 'sigqueue' payloads.
+ *
+ *  Handlers of the 'sig_record_fn_t' signature and handlers without arguments
+ *  receive the compact 32-byte 'sig_record' instead of the 128-byte
+ *  'sig_info_t'. Signals of such handlers are passed through a separate queue
+ *  of compact records, so the signal handler and the draining touch a quarter
+ *  of the memory. Signals of handlers taking 'sig_info_t' keep the full
+ *  record.
+ *
+ *  If the library is built with the 'SIGNALS_MANAGER_USE_STATS' definition,
+ *  the signal handler stamps each record with the arrival time, and the time
+ *  spent in the queue and the duration of the handler calls are collected in
+ *  per-signal histograms available via 'stats'.
+ *
+ *  A handler can be set with a 'rate_limit': the debounce policy calls the
+ *  handler once a burst of signals is over, the throttle policy calls it at
+ *  most once per interval. The deferred calls are driven by a timer wheel of
+ *  the processing thread, which sleeps until the nearest deadline. In the
+ *  reactor mode the descriptor returned by 'open_notify_fd' also becomes
+ *  readable at the nearest deadline, and the deferred calls are made by
+ *  'dispatch_pending' or 'poll_once'.
+ *
+ *  Timers set by 'set_timer' are POSIX timers delivering the real-time timer
+ *  signal, which is dispatched like any other signal, so their callbacks are
+ *  called by the processing thread without an extra thread or wakeup.
  */
 class manager final
 {
 public:
-    ~manager() { clear(); }
+#if defined(SIGNALS_MANAGER_USE_SIGNALFD)
+    static constexpr backend default_backend = backend::signalfd;
+#else
+    static constexpr backend default_backend = backend::sigaction;
+#endif
+    static constexpr std::size_t max_queue_capacity = SIGNALS_MANAGER_QUEUE_CAPACITY;
+    /// \brief  Maximum number of simultaneously set timers.
+    static constexpr std::size_t max_timers = 64;
+
+    using timer_id_t = std::uint32_t;
+    static constexpr timer_id_t invalid_timer = 0;
+
+    /// \brief  Options of the thread started by 'threaded_signals_processing'.
+    struct thread_options
+    {
+        /// \brief  CPUs the thread is pinned to, if empty - the affinity is
+        ///         inherited.
+        std::vector<int> cpus;
+        /// \brief  Scheduling policy.
+        sched_policy policy = sched_policy::other;
+        /// \brief  Static priority for the real-time scheduling policies.
+        int priority = 0;
+        /// \brief  Thread name, truncated to 15 characters.
+        std::string name;
+        /// \brief  Pre-fault and lock in RAM the top of the thread stack and
+        ///         the signals queues while the thread is running.
+        bool lock_memory = false;
+        /// \brief  Size of the locked part of the thread stack.
+        std::size_t locked_stack_size = 64 * 1024;
+    };
+
+    /// \brief  Signal manager options.
+    struct options
+    {
+        /// \brief  Signals delivery backend.
+        backend delivery = default_backend;
+        /// \brief  Signals queue capacity, must be in range [2, max_queue_capacity].
+        std::size_t queue_capacity = max_queue_capacity;
+        /// \brief  Policy applied to signals that do not fit into the queue.
+        overflow_policy overflow = overflow_policy::drop_newest;
+        /// \brief  Number of handler worker threads, if 0 - handlers are called
+        ///         by the processing thread.
+        std::size_t workers = 0;
+        /// \brief  Options of the processing thread.
+        thread_options thread;
+        /// \brief  Real-time signal delivering the timer expirations, it can
+        ///         not have a user handler while timers are set.
+        sig_num_t timer_signal = SIGRTMAX;
+        /// \brief  Real-time signal directed to the processing thread of the
+        ///         'backend::sigwait' backend to wake it up. Real-time signals
+        ///         are queued, so a wakeup never hides a user signal, and the
+        ///         signal can still have a user handler.
+        sig_num_t wake_signal = SIGRTMAX - 1;
+    };
+
+public:
+    /// \brief  Creates the signal manager with default options.
+    manager() : manager(options()) {}
+
+    /// \brief  Creates the signal manager.
+    /// \param  b - signals delivery backend.
+    explicit manager(backend b);
+
+    /// \brief  Creates the signal manager.
+    /// \param  opts - manager options.
+    explicit manager(const options& opts);
+
+    ~manager()
+    {
+        clear();
+        m_executor.stop();
+    }
+
+    backend get_backend() const { return m_backend; }
+
+    std::size_t queue_capacity() const { return m_sig_queue.capacity(); }
+
+    /// \brief  Returns the number of signals merged with the queued ones
+    ///         because of the queue overflow.
+    /// \param  sig - signal number.
+    std::uint64_t coalesced(sig_num_t sig) const;
+
+    /// \brief  Returns the number of signals lost because of the queue overflow.
+    /// \param  sig - signal number.
+    std::uint64_t dropped(sig_num_t sig) const;
+
+    overflow_policy get_overflow_policy() const { return m_overflow; }
+
+    /// \brief  Returns the statistics snapshot. The handled counts and the
+    ///         histograms are empty if the library is built without the
+    ///         'SIGNALS_MANAGER_USE_STATS' definition.
+    manager_stats stats() const;
+
+    /// \brief  Cancels the timer and releases its slot. Expirations that are
+    ///         already delivered to the manager are discarded.
+    /// \param  id - timer identifier returned by 'set_timer'.
+    /// \return True - the timer has been cancelled. False - the timer does not
+    ///     exist.
+    bool cancel_timer(timer_id_t id);
 
     void clear();
 
+    /// \brief  Stops handling signals in the external reactor. For the
+    ///         'backend::sigaction' backend must be called by the thread that
+    ///         has opened the descriptor.
+    void close_notify_fd();
+
+    /// \brief  Calls handlers of the pending signals on the caller's thread
+    ///         without blocking.
+    /// \param  max_count - maximum number of signal records to be dispatched,
+    ///         the rest of them stay pending. Coalesced signals are not limited.
+    /// \return Number of dispatched signals.
+    std::size_t dispatch_pending(std::size_t max_count = std::numeric_limits<std::size_t>::max());
+
     bool is_stopped() const { return m_is_stop; }
 
+    /// \brief  Starts handling signals in the external reactor. Signals of
+    ///         the handlers set later are picked up by the next
+    ///         'dispatch_pending' call. For the
+    ///         'backend::sigaction' backend the registered signals are
+    ///         unblocked in the calling thread, so the reactor thread must
+    ///         call it.
+    /// \return Descriptor that becomes readable when signals are pending or
+    ///         a deferred call of a rate limit is due, or -1 if the backend is 'backend::sigwait', signal handling
+    ///         process has started or an error has occurred.
+    int open_notify_fd();
+
+    /// \brief  Calls handlers of the pending signals and the due deferred
+    ///         calls of the rate limits on the caller's thread if there are
+    ///         any. When nothing is pending and no deferred call is scheduled,
+    ///         the call costs two atomic loads: no syscalls and no locks. The
+    ///         signals must be
+    ///         delivered to a thread by the 'sigaction' handler, e.g. after
+    ///         'open_notify_fd' has been called by the polling thread. For the
+    ///         'backend::signalfd' backend the signalfd is read on each call.
+    /// \return Number of dispatched signals.
+    std::size_t poll_once()
+    {
+        if (! m_has_pending.load(std::memory_order_relaxed) && ! m_sig_fd.is_open()) {
+            const std::uint64_t deadline = m_next_deadline.load(std::memory_order_relaxed);
+            if ((deadline == m_timers.never) || (details::monotonic_ns() / 1000000 < deadline)) {
+                return 0;
+            }
+        }
+        return dispatch_pending();
+    }
+
     /// \brief  Remove the handler for the specified signal.
     /// \param  sig - signal number.
     void remove_handler(sig_num_t sig);
 
     /// \brief  Changing a signal handler.
     /// \param  sig - signal number.
-    /// \param  func - new custom signal handler.
+    /// \param  func - new custom signal handler, a callable with one of the
+    ///         signatures: 'void()', 'void(sig_num_t, const sig_info_t&)', the
+    ///         compact 'void(sig_num_t, const sig_record&)' or the coalesced
+    ///         'void(sig_num_t, std::size_t)'.
+    /// \param  prio - handler priority.
     /// \return True - signal handler has been installed successfully.
-    ///     False - signal handling process has started.
-    bool reset_handler(sig_num_t sig, std::function<void()> func);
+    ///     False - coalesced handler is set for a real-time signal.
+    template<typename TFunc>
+    bool reset_handler(sig_num_t sig, TFunc&& func, priority prio = priority::normal)
+    {
+        return install_handler(sig, make_handler(std::forward<TFunc>(func), prio), true);
+    }
 
-    /// \brief  Changing a signal handler.
+    /// \brief  Changing a signal handler with the rate limit.
     /// \param  sig - signal number.
-    /// \param  func - new custom signal handler.
+    /// \param  func - new custom signal handler, see 'reset_handler'.
+    /// \param  limit - rate limit of the handler calls.
+    /// \param  prio - handler priority.
     /// \return True - signal handler has been installed successfully.
-    ///     False - signal handling process has started.
-    bool reset_handler(sig_num_t sig, sig_handler_fn_t func);
+    ///     False - coalesced handler is set for a real-time signal or the rate
+    ///     limit has a zero interval or neither edge.
+    template<typename TFunc>
+    bool reset_handler(sig_num_t sig, TFunc&& func, const rate_limit& limit, priority prio = priority::normal)
+    {
+        handler_node node = make_handler(std::forward<TFunc>(func), prio);
+        node.limit = limit;
+        return install_handler(sig, std::move(node), true);
+    }
 
-    /// \brief  Setting a signal handler.
+    /// \brief  Setting a batch signal handler.
     /// \param  sig - signal number.
-    /// \param  func - custom signal handler.
+    /// \param  func - custom signal handler with the signature
+    ///         'void(sig_num_t, const sig_info_t*, std::size_t)', receives all
+    ///         records of the signal received in one wakeup.
+    /// \param  prio - handler priority.
     /// \return True - signal handler has been installed successfully.
-    ///     False - signal handler has already been installed or signal handling
-    ///     process has started.
-    bool set_handler(sig_num_t sig, std::function<void()> func);
+    ///     False - signal handler has already been installed.
+    template<typename TFunc>
+    bool set_batch_handler(sig_num_t sig, TFunc&& func, priority prio = priority::normal)
+    {
+        static_assert(std::is_invocable<typename std::decay<TFunc>::type&, sig_num_t, const sig_info_t*, std::size_t>::value,
+                      "Unsupported batch signal handler signature");
+
+        handler_node node;
+        node.func = [f = std::forward<TFunc>(func)](sig_num_t sig, const void* p_infos, std::size_t count) mutable -> void {
+            f(sig, static_cast<const sig_info_t*>(p_infos), count);
+        };
+        node.kind = handler_kind::batch;
+        node.prio = prio;
+        return install_handler(sig, std::move(node), false);
+    }
 
     /// \brief  Setting a signal handler.
     /// \param  sig - signal number.
-    /// \param  func - custom signal handler.
+    /// \param  func - custom signal handler, a callable with one of the
+    ///         signatures: 'void()', 'void(sig_num_t, const sig_info_t&)', the
+    ///         compact 'void(sig_num_t, const sig_record&)' or the coalesced
+    ///         'void(sig_num_t, std::size_t)' (standard signals only).
+    /// \param  prio - handler priority.
+    /// \return True - signal handler has been installed successfully.
+    ///     False - signal handler has already been installed or coalesced
+    ///     handler is set for a real-time signal.
+    template<typename TFunc>
+    bool set_handler(sig_num_t sig, TFunc&& func, priority prio = priority::normal)
+    {
+        return install_handler(sig, make_handler(std::forward<TFunc>(func), prio), false);
+    }
+
+    /// \brief  Setting a signal handler with the rate limit. The debounced or
+    ///         throttled handler receives the last record of the suppressed
+    ///         signals, the coalesced handler receives their number.
+    /// \param  sig - signal number.
+    /// \param  func - custom signal handler, see 'set_handler'.
+    /// \param  limit - rate limit of the handler calls.
+    /// \param  prio - handler priority.
     /// \return True - signal handler has been installed successfully.
-    ///     False - signal handler has already been installed or signal handling
-    ///     process has started.
-    bool set_handler(sig_num_t sig, sig_handler_fn_t func);
+    ///     False - signal handler has already been installed, coalesced
+    ///     handler is set for a real-time signal or the rate limit has a zero
+    ///     interval or neither edge.
+    template<typename TFunc>
+    bool set_handler(sig_num_t sig, TFunc&& func, const rate_limit& limit, priority prio = priority::normal)
+    {
+        handler_node node = make_handler(std::forward<TFunc>(func), prio);
+        node.limit = limit;
+        return install_handler(sig, std::move(node), false);
+    }
+
+    /// \brief  Setting a one-shot or periodic timer. The timer is a POSIX
+    ///         timer delivering the 'options::timer_signal' real-time signal,
+    ///         so its callback is called by the thread processing signals,
+    ///         with the nanosecond resolution of the CLOCK_MONOTONIC clock.
+    /// \param  delay - delay of the first expiration.
+    /// \param  func - timer callback, a callable with the signature 'void()'
+    ///         or 'void(std::size_t)' receiving the number of expirations
+    ///         since the previous call, more than 1 if the callback is late.
+    /// \param  period - period of the timer, if 0 - the timer fires once.
+    /// \return Timer identifier. 'invalid_timer' - all timers are in use, the
+    ///     timer signal has a user handler or the timer can not be created.
+    /// \note   A fired one-shot timer keeps its slot until it is cancelled or
+    ///         the slot is reused by another 'set_timer' call.
+    template<typename TFunc>
+    timer_id_t set_timer(const std::chrono::nanoseconds& delay, TFunc&& func,
+                         const std::chrono::nanoseconds& period = std::chrono::nanoseconds(0))
+    {
+        return start_timer(delay, period, make_timer(std::forward<TFunc>(func)));
+    }
 
     void signals_processing();
 
@@ -130,49 +446,377 @@ public:
 
     void stop_processing();
 
-    void threaded_signals_processing(const std::chrono::milliseconds& msec = std::chrono::milliseconds(0));
+    /// \brief  Starts signal processing in a new thread with the thread options
+    ///         the manager has been created with.
+    /// \param  msec - wait timeout of the processing loop.
+    /// \return True - the thread has been started and the thread options have
+    ///     been applied. False - the processing thread is already running or
+    ///     the thread options can not be applied, e.g. the real-time policy
+    ///     requires privileges.
+    bool threaded_signals_processing(const std::chrono::milliseconds& msec = std::chrono::milliseconds(0));
 
 private:
-    using handlers_map_t = std::unordered_map<sig_num_t, sig_handler_fn_t>;
-    using signals_queue_t = details::signals_queue_t<sig_info_t, 31>;
+    enum class handler_kind : std::uint8_t
+    {
+        none,
+        queued,
+        compact,
+        coalesced,
+        batch,
+        /// \brief  Dispatcher of the timer signal.
+        timer
+    };
+
+    /// \brief  Handler is called with the signal records and their number:
+    ///         'sig_record' for the compact handler, 'sig_info_t' for the
+    ///         others. Coalesced handler is called with nullptr and the number
+    ///         of coalesced signals.
+    using handler_fn_t = details::function<void(sig_num_t, const void*, std::size_t), 32>;
+
+    struct handler_node
+    {
+        handler_fn_t func;
+        handler_kind kind = handler_kind::none;
+        priority prio = priority::normal;
+        rate_limit limit;
+        /// \brief  Unique identifier, the rate limit state of a replaced
+        ///         handler is not applied to the new one.
+        std::uint64_t id = 0;
+    };
+
+    /// \brief  Handler call passed to the worker threads.
+    struct handler_task
+    {
+        const handler_node* p_handler;
+        sig_num_t sig;
+        std::size_t count;
+        sig_info_t info;
+        sig_record record;
+        std::vector<sig_info_t> infos;
+
+        void operator()();
+    };
+
+    static constexpr std::size_t priority_levels = static_cast<std::size_t>(priority::critical) + 1;
+    /// \brief  Level argument that matches handlers of any priority.
+    static constexpr std::size_t all_levels = priority_levels;
+
+    /// \brief  Queued signal record, 'sig_info_t' or the compact 'sig_record'.
+    template<typename TInfo>
+    struct queued_record
+    {
+        TInfo info;
+#if defined(SIGNALS_MANAGER_USE_STATS)
+        /// \brief  Arrival time in nanoseconds.
+        std::uint64_t arrival_ns;
+#endif
+    };
+
+    /// \brief  Rate limit state of a signal, owned by the dispatching thread.
+    struct rate_state
+    {
+        std::uint64_t handler_id = 0;
+        /// \brief  Number of the suppressed signals.
+        std::size_t count = 0;
+        bool is_pending = false;
+        /// \brief  Last suppressed record.
+        sig_info_t info;
+    };
+
+#if defined(SIGNALS_MANAGER_USE_STATS)
+    struct signal_histograms
+    {
+        details::histogram latency;
+        details::histogram duration;
+        std::atomic<std::uint64_t> handled = {0};
+        /// \brief  Arrival time of the oldest pending coalesced signal.
+        std::atomic<std::uint64_t> pending_since = {0};
+    };
+#endif
+
+    static constexpr std::size_t batch_size = 16;
+
+    using counters_t = std::atomic<std::uint64_t>[_NSIG];
+    using signals_queue_t = details::signals_queue_t<queued_record<sig_info_t>, max_queue_capacity>;
+    using records_queue_t = details::signals_queue_t<queued_record<sig_record>, max_queue_capacity>;
 
 private:
-    void erase(sig_num_t sig);
+    static bool apply_thread_options();
 
-    static void on_signal_fn(sig_num_t /*sig_num*/, sig_info_t* sig_info, void*)
+    /// \brief  Arms the notify timer at the nearest rate limit deadline.
+    static void arm_notify_timer();
+
+    static void begin_dispatch();
+
+    static void call(const handler_node& handler, sig_num_t sig, const void* p_infos, std::size_t count);
+
+    static void close_backend(const details::sig_set_t& set);
+
+    static void dispatch(const sig_info_t& info);
+
+    static void dispatch(const sig_record& record);
+
+    static void dispatch_batches(std::size_t level);
+
+    static std::size_t dispatch_coalesced(std::uint64_t& mask, std::size_t level);
+
+    static std::size_t dispatch_cycle(std::size_t max_count);
+
+    static void dispatch_limited(const handler_node& handler, sig_num_t sig, const sig_info_t* p_info,
+                                 std::size_t count);
+
+    template<typename TInfo>
+    static std::size_t dispatch_queue(details::signals_queue_t<queued_record<TInfo>, max_queue_capacity>& queue,
+                                      std::size_t max_count, bool is_ordered);
+
+    static void dispatch_record(const sig_info_t& info, bool is_ordered);
+
+    static void dispatch_record(const sig_record& record, bool is_ordered);
+
+    static std::size_t dispatch_records(std::size_t max_count, bool is_ordered);
+
+    static void dispatch_signals();
+
+    static void dispatch_timer(const sig_info_t& info);
+
+    static void dispatch_timers();
+
+    static void end_dispatch();
+
+    static void erase(sig_num_t sig);
+
+    static void fire(const handler_node& handler, sig_num_t sig, rate_state& state);
+
+    static bool install(sig_num_t sig, details::sig_action_fn_t on_signal);
+
+    bool install_handler(sig_num_t sig, handler_node&& node, bool is_reset);
+
+    template<typename TFunc>
+    static handler_node make_handler(TFunc&& func, priority prio)
     {
-        m_sig_queue.push(*sig_info);
-        wake();
+        using func_t = typename std::decay<TFunc>::type;
+
+        handler_node node;
+        if constexpr (std::is_invocable<func_t&, sig_num_t, const sig_info_t&>::value) {
+            node.func = [f = std::forward<TFunc>(func)](sig_num_t sig, const void* p_info, std::size_t) mutable -> void {
+                f(sig, *static_cast<const sig_info_t*>(p_info));
+            };
+            node.kind = handler_kind::queued;
+        } else if constexpr (std::is_invocable<func_t&, sig_num_t, const sig_record&>::value) {
+            node.func = [f = std::forward<TFunc>(func)](sig_num_t sig, const void* p_record, std::size_t) mutable -> void {
+                f(sig, *static_cast<const sig_record*>(p_record));
+            };
+            node.kind = handler_kind::compact;
+        } else if constexpr (std::is_invocable<func_t&, sig_num_t, std::size_t>::value) {
+            node.func = [f = std::forward<TFunc>(func)](sig_num_t sig, const void*, std::size_t count) mutable -> void {
+                f(sig, count);
+            };
+            node.kind = handler_kind::coalesced;
+        } else {
+            static_assert(std::is_invocable<func_t&>::value, "Unsupported signal handler signature");
+            node.func = [f = std::forward<TFunc>(func)](sig_num_t, const void*, std::size_t) mutable -> void {
+                f();
+            };
+            node.kind = handler_kind::compact;
+        }
+        node.prio = prio;
+        return node;
     }
 
-    static bool pop_signal(sig_info_t& sig_info)
+    template<typename TFunc>
+    static handler_node make_timer(TFunc&& func)
     {
-        if (m_sig_queue.empty()) {
-            return false;
+        using func_t = typename std::decay<TFunc>::type;
+
+        handler_node node;
+        if constexpr (std::is_invocable<func_t&, std::size_t>::value) {
+            node.func = [f = std::forward<TFunc>(func)](sig_num_t, const void* p_info, std::size_t) mutable -> void {
+                f(static_cast<std::size_t>(static_cast<const sig_info_t*>(p_info)->si_overrun) + 1);
+            };
+        } else {
+            static_assert(std::is_invocable<func_t&>::value, "Unsupported timer callback signature");
+            node.func = [f = std::forward<TFunc>(func)](sig_num_t, const void*, std::size_t) mutable -> void {
+                f();
+            };
         }
-        m_sig_queue.pop(sig_info);
-        return true;
+        node.kind = handler_kind::queued;
+        return node;
+    }
+
+    static bool is_wake(const sig_info_t& info)
+    {
+        return (info.si_code == SI_QUEUE) && (info.si_value.sival_ptr == &m_wakes) && (info.si_pid == ::getpid());
+    }
+
+    static bool make_sigset(details::sig_set_t& set);
+
+    static void mark_pending(sig_num_t sig)
+    {
+        m_pending_counts[sig].fetch_add(1, std::memory_order_relaxed);
+        m_pending_mask.fetch_or(std::uint64_t(1) << (sig - 1), std::memory_order_release);
+    }
+
+    static void on_coalesced_signal_fn(sig_num_t sig_num, sig_info_t* /*sig_info*/, void*)
+    {
+#if defined(SIGNALS_MANAGER_USE_STATS)
+        std::uint64_t since = 0;
+        m_stats[sig_num].pending_since.compare_exchange_strong(since, details::monotonic_ns(), std::memory_order_relaxed);
+#endif
+        mark_pending(sig_num);
+        m_has_pending.store(true, std::memory_order_release);
+        wake();
+    }
+
+    static void on_compact_signal_fn(sig_num_t /*sig_num*/, sig_info_t* sig_info, void*)
+    {
+        push_signal(to_record(*sig_info));
+        m_has_pending.store(true, std::memory_order_release);
+        wake();
     }
 
+    static void on_signal_fn(sig_num_t /*sig_num*/, sig_info_t* sig_info, void*)
+    {
+        push_signal(*sig_info);
+        m_has_pending.store(true, std::memory_order_release);
+        wake();
+    }
+
+    static bool open_backend(details::sig_set_t& set);
+
     static void processing();
 
     static void processing_to(const std::chrono::milliseconds& msec, bool exit_after_timeout);
 
-    static void wait() { m_sem.wait(); }
+    template<typename TInfo>
+    static void push(details::signals_queue_t<queued_record<TInfo>, max_queue_capacity>& queue, const TInfo& info);
+
+    static void push_signal(const sig_info_t& info);
+
+    static void push_signal(const sig_record& record);
+
+    static void reclaim();
+
+    static void release_thread_options();
+
+    static void release_timer(std::size_t slot);
+
+    timer_id_t start_timer(const std::chrono::nanoseconds& delay, const std::chrono::nanoseconds& period,
+                           handler_node&& node);
+
+    static void submit(handler_task&& task);
 
-    static void wait(const std::chrono::milliseconds& ms) { m_sem.timed_wait(ms); }
+    static bool timers_timeout(std::chrono::milliseconds& msec);
 
-    static void wake() { m_sem.post(); }
+    static sig_record to_record(const sig_info_t& info)
+    {
+        sig_record record;
+        record.signo = info.si_signo;
+        record.code = info.si_code;
+        record.pid = info.si_pid;
+        record.uid = info.si_uid;
+        record.status = info.si_status;
+        record.value = info.si_value;
+        return record;
+    }
+
+    /// \brief  Returns the 'sigaction' handler of the signals handled by the
+    ///         handler of the kind.
+    static details::sig_action_fn_t trampoline(handler_kind kind)
+    {
+        switch (kind) {
+        case handler_kind::compact:
+            return &on_compact_signal_fn;
+        case handler_kind::coalesced:
+            return &on_coalesced_signal_fn;
+        default:
+            return &on_signal_fn;
+        }
+    }
+
+    static void retire(handler_node* p_node);
+
+    static void update_sigset(details::sig_set_t& set, std::uint64_t& generation);
+
+    static void wait(const details::sig_set_t& set, const std::chrono::milliseconds* p_msec = nullptr);
+
+    static void wake()
+    {
+        if (m_backend == backend::signalfd) {
+            m_event.post();
+        } else if (m_backend == backend::sigwait) {
+            wake_waiter();
+        } else if (m_is_attached) {
+            m_event.post();
+        } else {
+            m_sem.post();
+        }
+    }
+
+    static void wake_waiter();
 
 private:
+    static backend m_backend;
+    static overflow_policy m_overflow;
     static std::atomic_bool m_is_stop;
     static details::semaphore m_sem;
+    static details::event_fd m_event;
+    static details::signal_fd m_sig_fd;
+    static details::epoll_fd m_notify_fd;
+    static details::timer_fd m_notify_timer;
+    static std::uint64_t m_armed_deadline;
+    static std::atomic<std::uint64_t> m_next_deadline;
+    static std::atomic_bool m_is_attached;
+    static std::atomic_bool m_has_pending;
+    static details::sig_set_t m_attached_set;
+    static std::uint64_t m_attached_generation;
     static std::unique_ptr<std::thread> m_p_thread;
+    static thread_options m_thread_options;
+
+    static std::atomic_bool m_is_waiting;
+    static std::atomic<std::size_t> m_wakes;
+    static ::pthread_t m_wait_thread;
+    static sig_num_t m_wake_sig;
+    static sig_info_t m_wait_infos[batch_size];
+    static std::size_t m_wait_count;
+
+    static std::mutex m_dispatch_mutex;
+    static std::atomic<std::size_t> m_readers;
+    static details::executor<handler_task, priority_levels> m_executor;
 
     static std::mutex m_handlers_mutex;
-    static handlers_map_t m_handlers;
+    static std::atomic<handler_node*> m_handlers[_NSIG];
+    static std::atomic<std::uint64_t> m_generation;
+    static std::atomic<std::size_t> m_prioritized;
+    static std::vector<sig_info_t> m_deferred_infos[priority_levels];
+    static std::vector<handler_node*> m_retired;
+    static std::atomic_bool m_has_retired;
+    static std::vector<sig_info_t> m_batch_infos[_NSIG];
+    static std::uint64_t m_batch_mask;
+    static std::uint64_t m_handler_ids;
+    static rate_state m_rates[_NSIG];
+    static details::timer_wheel<_NSIG> m_timers;
+
+    static sig_num_t m_timer_sig;
+    static std::uint32_t m_timer_serial;
+    static std::atomic<handler_node*> m_timer_handlers[max_timers];
+    static ::timer_t m_timer_handles[max_timers];
+    static bool m_is_periodic[max_timers];
+    static std::atomic_bool m_is_fired[max_timers];
 
     static signals_queue_t m_sig_queue;
+    static records_queue_t m_record_queue;
+    static counters_t m_queued;
+    static counters_t m_dropped;
+    static counters_t m_coalesced;
+
+    static std::atomic<std::uint64_t> m_pending_mask;
+    static counters_t m_pending_counts;
+
+#if defined(SIGNALS_MANAGER_USE_STATS)
+    static signal_histograms m_stats[_NSIG];
+    static std::atomic<std::size_t> m_queue_depth;
+    static std::atomic<std::size_t> m_max_queue_depth;
+#endif
 };
 
 } // namespace signals
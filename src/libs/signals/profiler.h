@@ -0,0 +1,180 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2026 Chistyakov Alexander.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef _LIBS_SIGNALS_PROFILER_H_
+#define _LIBS_SIGNALS_PROFILER_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <sys/types.h>
+
+#include "signals/manager.h"
+
+namespace wstux {
+namespace signals {
+
+/**
+ *  \brief  In-process sampling CPU profiler.
+ *
+ *  Each attached thread gets a CLOCK_THREAD_CPUTIME_ID timer delivering the
+ *  profiling signal to the thread itself, so a thread is sampled in
+ *  proportion to the CPU time it consumes and idle threads cost nothing. The
+ *  signal handler captures the stack into a ring of the thread preallocated
+ *  by 'attach' and does not allocate or lock. The rings are drained by a
+ *  periodic timer of the manager, so the samples are aggregated into stack
+ *  counts by the thread processing signals, and 'folded' exports the counts
+ *  in the folded-stack format of the flame graph tools.
+ *
+ *  The overhead is proportional to the sampling frequency. Stacks are captured
+ *  by 'backtrace', which is loaded by 'start' so that the signal handler does
+ *  not trigger the lazy loading of the unwinder. Functions of the executable
+ *  are named only if it is linked with '-rdynamic'.
+ *
+ *  The profiling signal must not be handled by the manager.
+ */
+class profiler final
+{
+public:
+    /// \brief  Maximum number of simultaneously attached threads.
+    static constexpr std::size_t max_threads = 256;
+    /// \brief  Maximum number of captured frames.
+    static constexpr std::size_t max_depth = 32;
+
+    struct options
+    {
+        /// \brief  Profiling signal.
+        sig_num_t signal = SIGPROF;
+        /// \brief  Samples per second of the thread CPU time. The kernel
+        ///         checks thread CPU timers at the scheduler tick, so the
+        ///         effective rate is limited by CONFIG_HZ (often 250 Hz) and
+        ///         higher values yield fewer samples than requested.
+        std::size_t frequency = 99;
+        /// \brief  Number of samples a thread ring can keep between
+        ///         aggregations, the samples that do not fit are dropped.
+        std::size_t ring_capacity = 512;
+        /// \brief  Period of the aggregation on the processing thread.
+        std::chrono::milliseconds aggregation_period = std::chrono::milliseconds(100);
+    };
+
+public:
+    profiler() = delete;
+
+    /// \brief  Drains the rings of all threads into the stack counts. Called
+    ///         periodically by the manager, can also be called directly.
+    static void aggregate();
+
+    /// \brief  Starts sampling of the calling thread.
+    /// \return True - the thread has been attached. False - the profiler is
+    ///     not started, the thread is already attached, all slots are in use
+    ///     or the timer can not be created.
+    static bool attach();
+
+    /// \brief  Stops sampling of the calling thread. A thread exiting while
+    ///         attached is detached at its exit.
+    static void detach();
+
+    /// \brief  Returns the number of samples lost because of full rings.
+    static std::uint64_t dropped();
+
+    /// \brief  Exports the aggregated stacks in the folded format: frames from
+    ///         the root to the leaf separated by ';' and the number of samples.
+    static std::string folded();
+
+    /// \brief  Resets the aggregated stacks and counters.
+    static void reset();
+
+    /// \brief  Returns the number of aggregated samples.
+    static std::uint64_t samples();
+
+    /// \brief  Sets the profiling signal handler and the aggregation timer.
+    /// \return True - the profiler has been started. False - it is already
+    ///     started, the options are invalid or the timer can not be set.
+    static bool start(manager& sm, const options& opts);
+
+    /// \brief  Cancels the aggregation timer and aggregates the rest of the
+    ///         samples. Threads should be detached before, the samples of the
+    ///         attached threads are discarded.
+    static void stop(manager& sm);
+
+private:
+    struct sample
+    {
+        std::size_t depth;
+        void* frames[max_depth];
+    };
+
+    /// \brief  Single-producer single-consumer ring of the samples: the
+    ///         signal handler of the thread produces, the aggregation consumes.
+    struct ring
+    {
+        explicit ring(std::size_t capacity) : samples(capacity) {}
+
+        std::vector<sample> samples;
+        alignas(64) std::atomic<std::size_t> head = {0};
+        alignas(64) std::atomic<std::size_t> tail = {0};
+        std::atomic<std::uint64_t> dropped = {0};
+    };
+
+    struct stack_hash
+    {
+        std::size_t operator()(const std::vector<void*>& stack) const;
+    };
+
+private:
+    static void drain(ring& r);
+
+    static void on_signal_fn(sig_num_t sig_num, sig_info_t* sig_info, void*);
+
+private:
+    static std::atomic_bool m_is_running;
+    static sig_num_t m_sig;
+    static std::chrono::nanoseconds m_period;
+    static std::size_t m_capacity;
+    static manager::timer_id_t m_timer_id;
+
+    static std::mutex m_mutex;
+    static std::atomic<::pid_t> m_owners[max_threads];
+    static std::atomic<ring*> m_rings[max_threads];
+    static std::unordered_map<std::vector<void*>, std::uint64_t, stack_hash> m_stacks;
+    static std::uint64_t m_samples;
+    static std::uint64_t m_dropped;
+
+    static thread_local std::size_t m_slot;
+    /// \brief  Ring of the thread, accessed by the signal handler.
+    static thread_local ring* m_p_ring;
+    static thread_local ::timer_t m_timer;
+};
+
+} // namespace signals
+} // namespace wstux
+
+#endif /* _LIBS_SIGNALS_PROFILER_H_ */
@@ -0,0 +1,201 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2026 Chistyakov Alexander.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef _LIBS_SIGNALS_SHUTDOWN_ORCHESTRATOR_H_
+#define _LIBS_SIGNALS_SHUTDOWN_ORCHESTRATOR_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "signals/manager.h"
+
+namespace wstux {
+namespace signals {
+
+/// \brief  Reaction to a shutdown signal received during the shutdown.
+enum class shutdown_escalation
+{
+    /// The current phase stops waiting for its hooks.
+    next_phase,
+    /// The process exits immediately.
+    force_exit
+};
+
+/// \brief  Report of a finished shutdown phase.
+struct shutdown_phase_report
+{
+    std::string name;
+    std::chrono::nanoseconds duration;
+    /// \brief  Number of hooks that have not finished by the end of the phase.
+    std::size_t unfinished;
+    /// \brief  The phase has been ended by the deadline.
+    bool is_timed_out;
+    /// \brief  The phase has been ended by a repeated signal.
+    bool is_escalated;
+};
+
+/// \brief  Hook of a shutdown phase.
+using shutdown_hook_fn_t = std::function<void()>;
+
+/**
+ *  \brief  Graceful shutdown orchestrator.
+ *
+ *  The orchestrator sets handlers of the shutdown signals, 'SIGTERM' and
+ *  'SIGINT' by default. The first signal or a 'request' call starts the
+ *  shutdown thread, which runs the phases in the order they have been added.
+ *  Hooks of a phase run in parallel, each in its own thread, and the phase
+ *  ends when all its hooks have finished or its deadline has expired. Hooks
+ *  left running after the deadline are not waited for, so they must not
+ *  reference objects destroyed by the later phases.
+ *
+ *  A repeated signal ends the current phase or exits the process according to
+ *  the escalation policy. Signals received in one wakeup of the processing
+ *  thread are counted, so a repeated signal is not lost if it arrives before
+ *  the first one has been handled. When the last phase is over, the processing of the
+ *  manager is stopped.
+ *
+ *  Phases and hooks must be added before the shutdown starts. The
+ *  orchestrator must be destroyed while the manager does not process signals.
+ */
+class shutdown_orchestrator final
+{
+public:
+    struct options
+    {
+        /// \brief  Signals starting the shutdown.
+        std::vector<sig_num_t> signals = {SIGTERM, SIGINT};
+        /// \brief  Reaction to a signal received during the shutdown.
+        shutdown_escalation escalation = shutdown_escalation::next_phase;
+        /// \brief  Exit code of the forced exit.
+        int exit_code = 1;
+        /// \brief  Stop the processing of the manager after the last phase.
+        bool stop_processing = true;
+    };
+
+public:
+    explicit shutdown_orchestrator(manager& sm) : shutdown_orchestrator(sm, options()) {}
+
+    shutdown_orchestrator(manager& sm, const options& opts);
+
+    shutdown_orchestrator(const shutdown_orchestrator&) = delete;
+    shutdown_orchestrator& operator=(const shutdown_orchestrator&) = delete;
+
+    /// \brief  Removes the signal handlers and waits for the shutdown thread.
+    ~shutdown_orchestrator();
+
+    /// \brief  Adds the hook to the phase.
+    /// \param  name - phase name.
+    /// \param  hook - hook called in its own thread.
+    /// \return True - the hook has been added. False - the phase does not
+    ///     exist or the shutdown has already started.
+    bool add_hook(const std::string& name, shutdown_hook_fn_t hook);
+
+    /// \brief  Adds the phase after the phases added earlier.
+    /// \param  name - unique phase name.
+    /// \param  deadline - maximum duration of the phase, if 0 - the phase
+    ///         waits for all its hooks.
+    /// \return True - the phase has been added. False - the phase already
+    ///     exists or the shutdown has already started.
+    bool add_phase(const std::string& name, const std::chrono::milliseconds& deadline);
+
+    /// \brief  Returns true if the shutdown has finished.
+    bool is_done() const;
+
+    /// \brief  Returns true if the handlers of all shutdown signals have been
+    ///         installed.
+    bool is_installed() const { return m_is_installed; }
+
+    /// \brief  Returns true if the shutdown has started.
+    bool is_started() const;
+
+    /// \brief  Returns the reports of the finished phases.
+    std::vector<shutdown_phase_report> report() const;
+
+    /// \brief  Starts the shutdown as the first signal does.
+    /// \return True - the shutdown has been started. False - it has already
+    ///     been started.
+    bool request();
+
+    /// \brief  Waits for the end of the shutdown.
+    void wait();
+
+    /// \brief  Waits for the end of the shutdown.
+    /// \return True - the shutdown has finished.
+    bool wait(const std::chrono::milliseconds& msec);
+
+private:
+    struct phase
+    {
+        std::string name;
+        std::chrono::milliseconds deadline;
+        std::vector<shutdown_hook_fn_t> hooks;
+    };
+
+    /// \brief  State of the running phase shared with its hook threads, which
+    ///         may outlive the phase and the orchestrator.
+    struct phase_state
+    {
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::size_t hooks_left = 0;
+        bool is_escalated = false;
+    };
+
+private:
+    void escalate();
+
+    /// \brief  Handles 'count' shutdown signals received in one wakeup: the
+    ///         first one starts the shutdown, the others escalate it.
+    void on_signal(std::size_t count);
+
+    void run();
+
+private:
+    manager& m_manager;
+    options m_options;
+    bool m_is_installed;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::vector<phase> m_phases;
+    std::vector<shutdown_phase_report> m_reports;
+    bool m_is_started;
+    bool m_is_done;
+    /// \brief  Escalation received before the phase has been started.
+    bool m_is_escalation_pending;
+    std::thread m_thread;
+    std::shared_ptr<phase_state> m_p_phase;
+};
+
+} // namespace signals
+} // namespace wstux
+
+#endif /* _LIBS_SIGNALS_SHUTDOWN_ORCHESTRATOR_H_ */
@@ -0,0 +1,276 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2026 Chistyakov Alexander.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef _LIBS_SIGNALS_STATIC_MANAGER_H_
+#define _LIBS_SIGNALS_STATIC_MANAGER_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "signals/types.h"
+#include "signals/details/queue.h"
+#include "signals/details/semaphore.h"
+#include "signals/details/utils.h"
+
+#if ! defined(SIGNALS_MANAGER_QUEUE_CAPACITY)
+    #define SIGNALS_MANAGER_QUEUE_CAPACITY 31
+#endif
+
+namespace wstux {
+namespace signals {
+
+/**
+ *  \brief  Handler of the signal 'TSig' for the static signal manager.
+ *
+ *  The handler is a callable with the signature 'void()' or
+ *  'void(sig_num_t, const sig_info_t&)'.
+ */
+template<sig_num_t TSig, typename TFunc>
+struct handler
+{
+    static_assert((TSig > 0) && (TSig < _NSIG), "Invalid signal number");
+    static_assert((TSig != SIGSEGV) && (TSig != SIGKILL) && (TSig != SIGSTOP) && (TSig != SIGCONT),
+                  "Signal can not be handled");
+
+    static constexpr sig_num_t signal = TSig;
+
+    TFunc func;
+
+    void operator()(const sig_info_t& info)
+    {
+        if constexpr (std::is_invocable<TFunc&, sig_num_t, const sig_info_t&>::value) {
+            func(TSig, info);
+        } else {
+            static_assert(std::is_invocable<TFunc&>::value, "Unsupported signal handler signature");
+            func();
+        }
+    }
+};
+
+/// \brief  Creates the handler of the signal 'TSig' for the static signal
+///         manager.
+template<sig_num_t TSig, typename TFunc>
+handler<TSig, typename std::decay<TFunc>::type> make_handler(TFunc&& func)
+{
+    return handler<TSig, typename std::decay<TFunc>::type>{std::forward<TFunc>(func)};
+}
+
+/**
+ *  \brief  Signal manager with the set of signals fixed at build time.
+ *
+ *  The signal set is known at compile time, so there is no handlers table and
+ *  no type erasure: the signal number is matched against the handled signals
+ *  by a generated chain of comparisons, which the compiler turns into a jump
+ *  table, and the handlers are called directly and can be inlined.
+ *
+ *  Signals are delivered as with the 'backend::sigaction' backend of the
+ *  'manager': the signal handler pushes the record into the lock-free queue
+ *  and posts the semaphore, the processing thread unblocks the signals only
+ *  while it waits for the semaphore.
+ *
+ *  The state shared with the signal handler is static, so only one manager of
+ *  the same handlers set can exist at a time, and its signals must not be
+ *  handled by the 'manager' at the same time.
+ *
+ *  \code
+ *  auto sm = wstux::signals::static_manager(
+ *      wstux::signals::make_handler<SIGTERM>([&]() -> void { stop(); }),
+ *      wstux::signals::make_handler<SIGHUP>([&]() -> void { reload(); }));
+ *  sm.threaded_signals_processing();
+ *  \endcode
+ */
+template<typename... THandlers>
+class static_manager final
+{
+    static_assert(sizeof...(THandlers) > 0, "Static manager requires at least one handler");
+
+public:
+    /// \brief  Mask of the handled signals, bit 'sig - 1' is set for each signal.
+    static constexpr std::uint64_t signals_mask = ((std::uint64_t(1) << (THandlers::signal - 1)) | ...);
+
+    static_assert(__builtin_popcountll(signals_mask) == sizeof...(THandlers), "Signal has several handlers");
+
+    static constexpr std::size_t queue_capacity = SIGNALS_MANAGER_QUEUE_CAPACITY;
+
+public:
+    /// \brief  Blocks the signals in the calling thread and installs the
+    ///         signal handlers.
+    explicit static_manager(THandlers... handlers)
+        : m_handlers(std::move(handlers)...)
+    {
+        ::sigemptyset(&m_set);
+        (::sigaddset(&m_set, THandlers::signal), ...);
+        m_dropped.store(0, std::memory_order_relaxed);
+
+        m_is_installed = details::block_sigset(m_set)
+            && (details::register_signal_handler(THandlers::signal, &on_signal_fn) && ...);
+    }
+
+    ~static_manager()
+    {
+        stop_processing();
+        (details::unregister_signal_handler(THandlers::signal), ...);
+        details::unblock_sigset(m_set);
+
+        sig_info_t infos[batch_size];
+        while (m_queue.pop_bulk(infos, batch_size) > 0) {}
+    }
+
+    /// \brief  Calls handlers of the queued signals on the caller's thread
+    ///         without blocking.
+    /// \return Number of dispatched signals.
+    std::size_t dispatch_pending()
+    {
+        sig_info_t infos[batch_size];
+        std::size_t total = 0;
+        std::size_t count;
+        do {
+            count = m_queue.pop_bulk(infos, batch_size);
+            for (std::size_t i = 0; i < count; ++i) {
+                dispatch(infos[i], std::index_sequence_for<THandlers...>());
+            }
+            total += count;
+        } while (count == batch_size);
+        return total;
+    }
+
+    /// \brief  Returns the number of signals lost because of the queue overflow.
+    std::uint64_t dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+    /// \brief  Returns true if all the signal handlers have been installed.
+    bool is_installed() const { return m_is_installed; }
+
+    bool is_stopped() const { return m_is_stop; }
+
+    void signals_processing() { processing(nullptr, false); }
+
+    void signals_processing(const std::chrono::milliseconds& msec, bool exit_after_timeout = false)
+    {
+        processing(&msec, exit_after_timeout);
+    }
+
+    void stop_processing()
+    {
+        m_is_stop = true;
+        m_sem.post();
+        if (m_p_thread) {
+            m_p_thread->join();
+            m_p_thread.reset();
+        }
+    }
+
+    /// \brief  Starts signal processing in a new thread.
+    /// \return False if the processing thread is already running.
+    bool threaded_signals_processing(const std::chrono::milliseconds& msec = std::chrono::milliseconds(0))
+    {
+        if (m_p_thread) {
+            return false;
+        }
+        m_is_stop = false;
+        if (msec == std::chrono::milliseconds(0)) {
+            m_p_thread.reset(new std::thread([this]() -> void { processing(nullptr, false); }));
+        } else {
+            m_p_thread.reset(new std::thread([this, msec]() -> void { processing(&msec, false); }));
+        }
+        return true;
+    }
+
+private:
+    static constexpr std::size_t batch_size = 16;
+
+    using queue_t = details::signals_queue_t<sig_info_t, queue_capacity>;
+
+private:
+    static_manager(const static_manager&);
+    static_manager& operator=(const static_manager&);
+
+    template<std::size_t... TIdx>
+    void dispatch(const sig_info_t& info, std::index_sequence<TIdx...>)
+    {
+        const sig_num_t sig = info.si_signo;
+        ((sig == THandlers::signal ? (std::get<TIdx>(m_handlers)(info), true) : false) || ...);
+    }
+
+    static void on_signal_fn(sig_num_t /*sig_num*/, sig_info_t* sig_info, void*)
+    {
+        if (! m_queue.try_push(*sig_info)) {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+        m_sem.post();
+    }
+
+    void processing(const std::chrono::milliseconds* p_msec, bool exit_after_timeout)
+    {
+        if (! m_is_installed) {
+            return;
+        }
+
+        m_is_stop = false;
+        while (! m_is_stop) {
+            details::unblock_sigset(m_set);
+            if (p_msec) {
+                m_sem.timed_wait(*p_msec);
+            } else {
+                m_sem.wait();
+            }
+            details::block_sigset(m_set);
+            dispatch_pending();
+
+            if (exit_after_timeout) {
+                break;
+            }
+        }
+    }
+
+private:
+    std::tuple<THandlers...> m_handlers;
+    details::sig_set_t m_set;
+    bool m_is_installed = false;
+    std::atomic_bool m_is_stop = {false};
+    std::unique_ptr<std::thread> m_p_thread;
+
+    static details::semaphore m_sem;
+    static queue_t m_queue;
+    static std::atomic<std::uint64_t> m_dropped;
+};
+
+template<typename... THandlers>
+details::semaphore static_manager<THandlers...>::m_sem;
+
+template<typename... THandlers>
+typename static_manager<THandlers...>::queue_t static_manager<THandlers...>::m_queue;
+
+template<typename... THandlers>
+std::atomic<std::uint64_t> static_manager<THandlers...>::m_dropped = {0};
+
+} // namespace signals
+} // namespace wstux
+
+#endif /* _LIBS_SIGNALS_STATIC_MANAGER_H_ */
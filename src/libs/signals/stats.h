@@ -0,0 +1,72 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2026 Chistyakov Alexander.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef _LIBS_SIGNALS_STATS_H_
+#define _LIBS_SIGNALS_STATS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "signals/types.h"
+#include "signals/details/histogram.h"
+
+namespace wstux {
+namespace signals {
+
+/// \brief  Latency distribution in nanoseconds.
+using latency_histogram_t = details::histogram::snapshot;
+
+/// \brief  Statistics of a signal.
+struct signal_stats
+{
+    sig_num_t sig = 0;
+    /// \brief  Number of signals passed to the handler.
+    std::uint64_t handled = 0;
+    /// \brief  Number of signals lost because of the queue overflow.
+    std::uint64_t dropped = 0;
+    /// \brief  Number of signals merged with the queued ones.
+    std::uint64_t coalesced = 0;
+    /// \brief  Time from the signal arrival to its removal from the queue or
+    ///         the pending mask. Signals read from 'signalfd' or pulled by
+    ///         'sigwaitinfo' carry no arrival time and are not counted.
+    latency_histogram_t latency;
+    /// \brief  Duration of the handler calls.
+    latency_histogram_t duration;
+};
+
+/// \brief  Statistics of the signal manager.
+struct manager_stats
+{
+    /// \brief  Maximum number of records that were in the queue at once.
+    std::size_t max_queue_depth = 0;
+    /// \brief  Statistics of the signals that have a handler or have been
+    ///         received, in ascending order of the signal number.
+    std::vector<signal_stats> signals;
+};
+
+} // namespace signals
+} // namespace wstux
+
+#endif /* _LIBS_SIGNALS_STATS_H_ */
@@ -0,0 +1,152 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2026 Chistyakov Alexander.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef _LIBS_SIGNALS_THREAD_SIGNALS_H_
+#define _LIBS_SIGNALS_THREAD_SIGNALS_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include <sys/types.h>
+
+#include "signals/types.h"
+#include "signals/details/function.h"
+
+namespace wstux {
+namespace signals {
+
+/// \brief  Handle of a thread attached to 'thread_signals'.
+struct thread_handle
+{
+    std::size_t slot = static_cast<std::size_t>(-1);
+    ::pid_t tid = 0;
+    /// \brief  Attachment of the mailbox, changed by every 'attach'.
+    std::uint32_t generation = 0;
+
+    bool is_valid() const { return (tid != 0) && (generation != 0); }
+};
+
+/**
+ *  \brief  Signals directed to the threads.
+ *
+ *  The directed signal interrupts a specific thread: the sender sets message
+ *  bits in the mailbox of the thread and sends the signal to it by 'tgkill'.
+ *  The signal handler is installed without SA_RESTART, so a blocking system
+ *  call of the thread fails with EINTR, and a compute loop can check
+ *  'is_pending' with a single atomic load. The messages are handled by the
+ *  thread itself when it calls 'dispatch', which calls the thread-scoped
+ *  handler set by 'attach'. The handler is never called by the signal: the
+ *  signal only interrupts the thread, and the messages stay in the mailbox
+ *  until the thread calls 'dispatch'.
+ *
+ *  Each attachment of a mailbox gets a new generation, which is kept in the
+ *  handle. 'send' pins the mailbox by a compare-and-swap that checks the
+ *  generation, and 'detach' clears the generation and waits for the pinning
+ *  senders before freeing the mailbox. So a stale handle sets no bits in a
+ *  reused mailbox, and the signal is never sent to a thread that has
+ *  detached.
+ *
+ *  Each attached thread owns a mailbox on its own cache line, so senders
+ *  targeting different threads share no lock and no cache line. 'send' is
+ *  async-signal-safe and can be called from any thread or signal handler.
+ *
+ *  The directed signal must not be handled by 'manager', it is unblocked only
+ *  in the attached threads.
+ */
+class thread_signals final
+{
+public:
+    /// \brief  Maximum number of simultaneously attached threads.
+    static constexpr std::size_t max_threads = 256;
+
+    /// \brief  Thread-scoped handler called with the received message bits.
+    using handler_fn_t = details::function<void(std::uint32_t), 32>;
+
+public:
+    thread_signals() = delete;
+
+    /// \brief  Attaches the calling thread: claims a mailbox, sets the
+    ///         thread-scoped handler and unblocks the directed signal. The
+    ///         handler is called only by 'dispatch'.
+    /// \return True - the thread has been attached. False - the directed
+    ///     signal is not set, the thread is already attached or all mailboxes
+    ///     are in use.
+    static bool attach(handler_fn_t handler = nullptr);
+
+    /// \brief  Detaches the calling thread, the undispatched messages are
+    ///         discarded. Waits for the senders that have already pinned the
+    ///         mailbox.
+    static void detach();
+
+    /// \brief  Takes the messages of the calling thread and passes them to
+    ///         its handler.
+    /// \return Message bits taken, 0 - there are no messages.
+    static std::uint32_t dispatch();
+
+    /// \brief  Returns true if the calling thread has undispatched messages.
+    static bool is_pending();
+
+    /// \brief  Sends the messages to the thread.
+    /// \param  thread - handle of the attached thread.
+    /// \param  bits - non-zero message bits, merged with the undispatched ones.
+    /// \return True - the signal has been sent. False - the handle is stale
+    ///     or the signal can not be sent.
+    static bool send(const thread_handle& thread, std::uint32_t bits);
+
+    /// \brief  Returns the handle of the calling thread, invalid if the
+    ///         thread is not attached.
+    static thread_handle self();
+
+    /// \brief  Sets the directed signal handler.
+    /// \param  sig - directed signal, preferably a real-time one.
+    static bool set_signal(sig_num_t sig);
+
+    /// \brief  Restores the default action of the directed signal.
+    static void reset_signal();
+
+private:
+    struct alignas(64) mailbox
+    {
+        /// \brief  Generation in the high half, number of the senders that
+        ///         have pinned the mailbox in the low half.
+        std::atomic<std::uint64_t> state = {0};
+        std::atomic<std::uint32_t> bits = {0};
+        std::atomic<::pid_t> tid = {0};
+        /// \brief  Last generation, changed only by the owner of the mailbox.
+        std::uint32_t generation = 0;
+    };
+
+private:
+    static void on_signal_fn(sig_num_t /*sig_num*/, sig_info_t* /*sig_info*/, void*) {}
+
+private:
+    static sig_num_t m_sig;
+    static mailbox m_mailboxes[max_threads];
+};
+
+} // namespace signals
+} // namespace wstux
+
+#endif /* _LIBS_SIGNALS_THREAD_SIGNALS_H_ */
@@ -25,21 +25,137 @@
 #ifndef _LIBS_SIGNALS_TYPES_H_
 #define _LIBS_SIGNALS_TYPES_H_
 
+#include <chrono>
 #include <csignal>
+#include <cstddef>
 #include <functional>
 
 namespace wstux {
 namespace signals {
 
+/// \brief  Signals delivery backend.
+enum class backend
+{
+    /// Signals are intercepted by the 'sigaction' handler, placed in a queue
+    /// and the processing thread is woken up by a semaphore.
+    sigaction,
+    /// Signals are blocked in all threads and are read by the processing
+    /// thread via 'signalfd'.
+    signalfd,
+    /// Signals are blocked in all threads and are pulled synchronously by the
+    /// processing thread via 'sigwaitinfo'/'sigtimedwait'.
+    sigwait
+};
+
+/// \brief  Policy applied to a signal that does not fit into the full queue.
+enum class overflow_policy
+{
+    /// The new signal is dropped.
+    drop_newest,
+    /// The oldest queued signal is dropped to make room for the new one.
+    drop_oldest,
+    /// The new signal is merged with a queued signal of the same number, if
+    /// there is no such signal, the new signal is dropped.
+    coalesce
+};
+
+/// \brief  Signal handler priority.
+enum class priority
+{
+    low,
+    normal,
+    high,
+    /// Shutdown signals and the like.
+    critical
+};
+
+/// \brief  Rate limiting policy of a signal handler.
+enum class rate_policy
+{
+    /// Every signal is passed to the handler.
+    none,
+    /// The handler is called once when the signals stop arriving for the
+    /// interval.
+    debounce,
+    /// The handler is called at most once per interval.
+    throttle
+};
+
+/// \brief  Rate limit of a signal handler. Handler calls are driven by the
+///         dispatch thread, the suppressed signals are passed to the next call:
+///         the last record or the accumulated number of coalesced signals.
+struct rate_limit
+{
+    rate_policy policy = rate_policy::none;
+    std::chrono::milliseconds interval = std::chrono::milliseconds(0);
+    /// \brief  Call the handler at the first signal of a burst.
+    bool leading = false;
+    /// \brief  Call the handler after the interval if signals have been
+    ///         suppressed.
+    bool trailing = true;
+
+    /// \brief  Creates the debounce rate limit.
+    static rate_limit debounce(const std::chrono::milliseconds& msec, bool leading = false, bool trailing = true)
+    {
+        return rate_limit{rate_policy::debounce, msec, leading, trailing};
+    }
+
+    /// \brief  Creates the throttle rate limit.
+    static rate_limit throttle(const std::chrono::milliseconds& msec, bool leading = true, bool trailing = true)
+    {
+        return rate_limit{rate_policy::throttle, msec, leading, trailing};
+    }
+};
+
+/// \brief  Scheduling policy of the processing thread.
+enum class sched_policy
+{
+    /// The default time-sharing policy, 'SCHED_OTHER'.
+    other,
+    /// 'SCHED_FIFO' real-time policy.
+    fifo,
+    /// 'SCHED_RR' real-time policy.
+    round_robin
+};
+
 /// \brief  Signal number.
 using sig_num_t = int;
 
 /// \brief  Data structure containing signal information.
 using sig_info_t = ::siginfo_t;
 
+/// \brief  Compact signal record with the fields most handlers read.
+struct sig_record
+{
+    sig_num_t signo;
+    /// \brief  Signal code, e.g. 'SI_USER', 'SI_QUEUE' or 'CLD_EXITED'.
+    int code;
+    /// \brief  Sending process ID.
+    ::pid_t pid;
+    /// \brief  Real user ID of the sending process.
+    ::uid_t uid;
+    /// \brief  Exit value or signal of the child process for 'SIGCHLD'.
+    int status;
+    /// \brief  Value passed by 'sigqueue'.
+    ::sigval value;
+};
+
+static_assert(sizeof(sig_record) == 32, "Signal record must be 32 bytes");
+
 /// \brief  Signal handler signature.
 using sig_handler_fn_t = std::function<void(sig_num_t, const sig_info_t&)>;
 
+/// \brief  Compact signal handler signature.
+using sig_record_fn_t = std::function<void(sig_num_t, const sig_record&)>;
+
+/// \brief  Coalesced signal handler signature. The handler receives the number
+///         of signals received since the previous call.
+using sig_coalesced_fn_t = std::function<void(sig_num_t, std::size_t)>;
+
+/// \brief  Batch signal handler signature. The handler receives a contiguous
+///         span of records of the signal received in one wakeup.
+using sig_batch_fn_t = std::function<void(sig_num_t, const sig_info_t*, std::size_t)>;
+
 } // namespace signals
 } // namespace wstux
 
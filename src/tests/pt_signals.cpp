@@ -0,0 +1,461 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2026 Chistyakov Alexander.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <csignal>
+#include <algorithm>
+#include <cerrno>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <functional>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "signals/manager.h"
+#include "signals/profiler.h"
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+using wstux::signals::sig_info_t;
+using wstux::signals::sig_num_t;
+
+#if defined(SIGNALS_MANAGER_USE_BOOST_LOCKFREE)
+constexpr const char* kQueueName = "boost_lockfree";
+#else
+constexpr const char* kQueueName = "ring";
+#endif
+
+constexpr std::size_t kDispatchIterations = 10000000;
+constexpr std::size_t kBurstSize = 1000;
+constexpr std::size_t kLatencyIterations = 10000;
+constexpr std::size_t kProfilerIterations = 50000000;
+constexpr std::size_t kProfilerRounds = 7;
+constexpr std::size_t kQueueIterations = 1000000;
+constexpr std::size_t kSenderSignals = 20000;
+
+volatile std::size_t g_calls = 0;
+
+double ns_per_op(clock_type::time_point start, std::size_t count)
+{
+    const std::chrono::duration<double, std::nano> elapsed = clock_type::now() - start;
+    return elapsed.count() / static_cast<double>(count);
+}
+
+void report(const char* p_case, const char* p_impl, std::size_t handlers, double ns)
+{
+    std::printf("{\"case\":\"%s\",\"impl\":\"%s\",\"queue\":\"%s\",\"handlers\":%zu,\"ns_per_op\":%.2f}\n",
+                p_case, p_impl, kQueueName, handlers, ns);
+}
+
+void report_latency(const char* p_case, const char* p_impl, std::vector<double>& samples)
+{
+    std::sort(samples.begin(), samples.end());
+    const double p50 = samples[samples.size() / 2];
+    const double p99 = samples[samples.size() * 99 / 100];
+    const double p999 = samples[samples.size() * 999 / 1000];
+    std::printf("{\"case\":\"%s\",\"impl\":\"%s\",\"queue\":\"%s\",\"samples\":%zu,"
+                "\"p50_ns\":%.0f,\"p99_ns\":%.0f,\"p999_ns\":%.0f}\n",
+                p_case, p_impl, kQueueName, samples.size(), p50, p99, p999);
+}
+
+const char* backend_name(wstux::signals::backend b)
+{
+    switch (b) {
+    case wstux::signals::backend::sigaction: return "sigaction";
+    case wstux::signals::backend::signalfd:  return "signalfd";
+    case wstux::signals::backend::sigwait:   return "sigwait";
+    }
+    return "unknown";
+}
+
+const char* overflow_name(wstux::signals::overflow_policy policy)
+{
+    switch (policy) {
+    case wstux::signals::overflow_policy::drop_newest: return "drop_newest";
+    case wstux::signals::overflow_policy::drop_oldest: return "drop_oldest";
+    case wstux::signals::overflow_policy::coalesce:    return "coalesce";
+    }
+    return "unknown";
+}
+
+/// \brief  Sends the real-time signal, retrying while the kernel queue of
+///         pending signals is full.
+void send_signal(sig_num_t sig, int value)
+{
+    while ((::sigqueue(::getpid(), sig, ::sigval{value}) != 0) && (errno == EAGAIN)) {
+        std::this_thread::yield();
+    }
+}
+
+/// \brief  Per-dispatch cost of the handlers table lookup and the handler call.
+///         The 'std_function_map' implementation reproduces the former table:
+///         an unordered map of 'std::function' wrapping a 'std::function<void()>'.
+///         The 'flat_atomic_node' implementation is the current table: atomic
+///         pointers to the published handler nodes.
+void dispatch_table(std::size_t handlers)
+{
+    sig_info_t infos[64] = {};
+    for (std::size_t i = 0; i < handlers; ++i) {
+        infos[i].si_signo = static_cast<sig_num_t>(i + 1);
+    }
+
+    {
+        using handler_fn_t = std::function<void(sig_num_t, const sig_info_t&)>;
+        std::unordered_map<sig_num_t, handler_fn_t> table;
+        for (std::size_t i = 0; i < handlers; ++i) {
+            std::function<void()> func = []() -> void { g_calls = g_calls + 1; };
+            table.emplace(infos[i].si_signo, [func](sig_num_t, const sig_info_t&) -> void { func(); });
+        }
+
+        const clock_type::time_point start = clock_type::now();
+        for (std::size_t i = 0; i < kDispatchIterations; ++i) {
+            const sig_info_t& info = infos[i % handlers];
+            const auto it = table.find(info.si_signo);
+            if (it != table.cend()) {
+                it->second(info.si_signo, info);
+            }
+        }
+        report("dispatch_table", "std_function_map", handlers, ns_per_op(start, kDispatchIterations));
+    }
+
+    {
+        using handler_fn_t = wstux::signals::details::function<void(sig_num_t, const sig_info_t*, std::size_t), 32>;
+        handler_fn_t table[_NSIG];
+        for (std::size_t i = 0; i < handlers; ++i) {
+            table[infos[i].si_signo] = [](sig_num_t, const sig_info_t*, std::size_t) -> void { g_calls = g_calls + 1; };
+        }
+
+        const clock_type::time_point start = clock_type::now();
+        for (std::size_t i = 0; i < kDispatchIterations; ++i) {
+            const sig_info_t& info = infos[i % handlers];
+            const handler_fn_t& func = table[info.si_signo];
+            if (func) {
+                func(info.si_signo, &info, 1);
+            }
+        }
+        report("dispatch_table", "flat_inline", handlers, ns_per_op(start, kDispatchIterations));
+    }
+
+    {
+        using handler_fn_t = wstux::signals::details::function<void(sig_num_t, const sig_info_t*, std::size_t), 32>;
+        handler_fn_t nodes[_NSIG];
+        std::atomic<const handler_fn_t*> table[_NSIG] = {};
+        for (std::size_t i = 0; i < handlers; ++i) {
+            nodes[infos[i].si_signo] = [](sig_num_t, const sig_info_t*, std::size_t) -> void { g_calls = g_calls + 1; };
+            table[infos[i].si_signo].store(&nodes[infos[i].si_signo]);
+        }
+
+        const clock_type::time_point start = clock_type::now();
+        for (std::size_t i = 0; i < kDispatchIterations; ++i) {
+            const sig_info_t& info = infos[i % handlers];
+            const handler_fn_t* p_func = table[info.si_signo].load(std::memory_order_acquire);
+            if (p_func != nullptr) {
+                (*p_func)(info.si_signo, &info, 1);
+            }
+        }
+        report("dispatch_table", "flat_atomic_node", handlers, ns_per_op(start, kDispatchIterations));
+    }
+}
+
+/// \brief  Processing cost of a burst of queued real-time signals, including
+///         reading them from the kernel. The burst is sent to one signal, the
+///         other handlers are set for the rest of the real-time and standard
+///         signals, so the number of handlers is limited by the number of
+///         signals that can be handled.
+void dispatch_burst(wstux::signals::backend b, std::size_t handlers)
+{
+    using namespace std::chrono_literals;
+
+    wstux::signals::manager sm(b);
+    const sig_num_t sig = SIGRTMIN + 5;
+    std::size_t calls = 0;
+    sm.set_handler(sig, [&calls]() -> void { ++calls; });
+    std::size_t installed = 1;
+    for (sig_num_t other = SIGRTMAX; (other > 0) && (installed < handlers); --other) {
+        const bool is_skipped = (other == sig) || (other == SIGINT) || (other == SIGTERM);
+        if (! is_skipped && sm.set_handler(other, []() -> void {})) {
+            ++installed;
+        }
+    }
+
+    for (std::size_t i = 0; i < kBurstSize; ++i) {
+        send_signal(sig, static_cast<int>(i));
+    }
+
+    const clock_type::time_point start = clock_type::now();
+    sm.signals_processing(0ms, true);
+    report("dispatch_burst", backend_name(b), installed, ns_per_op(start, calls));
+}
+
+/// \brief  Multi-producer push and single consumer pop cost of the signals
+///         queue variant the library is built with, for the full and the
+///         compact signal records.
+template<typename TInfo>
+void queue_mpsc(const char* p_record, std::size_t producers)
+{
+    wstux::signals::details::signals_queue_t<TInfo, 1024> queue;
+    std::atomic_bool is_start = {false};
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < producers; ++i) {
+        threads.emplace_back([&queue, &is_start, producers]() -> void {
+            TInfo info = {};
+            while (! is_start.load(std::memory_order_acquire)) {}
+            for (std::size_t n = 0; n < kQueueIterations / producers; ++n) {
+                while (! queue.try_push(info)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    const std::size_t total = (kQueueIterations / producers) * producers;
+    TInfo infos[16];
+    const clock_type::time_point start = clock_type::now();
+    is_start.store(true, std::memory_order_release);
+    for (std::size_t popped = 0; popped < total;) {
+        const std::size_t count = queue.pop_bulk(infos, 16);
+        if (count == 0) {
+            std::this_thread::yield();
+        }
+        popped += count;
+    }
+    const double ns = ns_per_op(start, total);
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    std::printf("{\"case\":\"queue_mpsc\",\"queue\":\"%s\",\"record\":\"%s\",\"producers\":%zu,\"ns_per_op\":%.2f}\n",
+                kQueueName, p_record, producers, ns);
+}
+
+/// \brief  Cost of delivering a burst of real-time signals that overflows
+///         the queue, and the number of signals lost with the overflow policy.
+///         The signals are handled by the sending thread, so the processing
+///         thread does not drain the queue during the burst.
+void queue_saturation(wstux::signals::overflow_policy policy)
+{
+    using namespace std::chrono_literals;
+    const sig_num_t sig = SIGRTMIN + 5;
+
+    wstux::signals::manager::options opts;
+    opts.delivery = wstux::signals::backend::sigaction;
+    opts.overflow = policy;
+    wstux::signals::manager sm(opts);
+    std::size_t calls = 0;
+    sm.set_handler(sig, [&calls]() -> void { ++calls; });
+
+    const clock_type::time_point start = clock_type::now();
+    for (std::size_t i = 0; i < kBurstSize; ++i) {
+        send_signal(sig, static_cast<int>(i));
+    }
+    const double ns = ns_per_op(start, kBurstSize);
+    sm.signals_processing(0ms, true);
+
+    std::printf("{\"case\":\"queue_saturation\",\"impl\":\"%s\",\"queue\":\"%s\",\"capacity\":%zu,"
+                "\"sent\":%zu,\"handled\":%zu,\"dropped\":%llu,\"coalesced\":%llu,\"ns_per_signal\":%.2f}\n",
+                overflow_name(policy), kQueueName, sm.queue_capacity(), kBurstSize, calls,
+                static_cast<unsigned long long>(sm.dropped(sig)), static_cast<unsigned long long>(sm.coalesced(sig)), ns);
+}
+
+/// \brief  Sustained rate of real-time signals sent by 'sigqueue' from several
+///         threads and handled by the processing thread.
+void sigqueue_throughput(wstux::signals::backend b, std::size_t senders)
+{
+    const sig_num_t sig = SIGRTMIN + 5;
+
+    wstux::signals::manager sm(b);
+    std::atomic<std::size_t> calls = {0};
+    sm.set_handler(sig, [&calls]() -> void { calls.fetch_add(1, std::memory_order_relaxed); });
+    sm.threaded_signals_processing();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    const std::size_t total = kSenderSignals * senders;
+    const clock_type::time_point start = clock_type::now();
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < senders; ++i) {
+        threads.emplace_back([sig]() -> void {
+            for (std::size_t n = 0; n < kSenderSignals; ++n) {
+                send_signal(sig, static_cast<int>(n));
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    const std::chrono::duration<double> send_time = clock_type::now() - start;
+
+    const clock_type::time_point deadline = clock_type::now() + std::chrono::seconds(5);
+    while ((calls.load(std::memory_order_relaxed) + sm.dropped(sig) < total) && (clock_type::now() < deadline)) {
+        std::this_thread::yield();
+    }
+    const std::chrono::duration<double> elapsed = clock_type::now() - start;
+    sm.stop_processing();
+
+    std::printf("{\"case\":\"sigqueue_throughput\",\"impl\":\"%s\",\"queue\":\"%s\",\"senders\":%zu,"
+                "\"sent\":%zu,\"handled\":%zu,\"dropped\":%llu,\"sent_per_sec\":%.0f,\"handled_per_sec\":%.0f}\n",
+                backend_name(b), kQueueName, senders, total, calls.load(), static_cast<unsigned long long>(sm.dropped(sig)),
+                static_cast<double>(total) / send_time.count(), static_cast<double>(calls.load()) / elapsed.count());
+}
+
+/// \brief  Cost of checking for pending signals in a polling loop when there
+///         are none.
+void poll_idle()
+{
+    wstux::signals::manager sm(wstux::signals::backend::sigaction);
+    sm.set_handler(SIGTERM, []() -> void {});
+    sm.open_notify_fd();
+
+    const clock_type::time_point start = clock_type::now();
+    for (std::size_t i = 0; i < kDispatchIterations; ++i) {
+        g_calls = g_calls + sm.poll_once();
+    }
+    report("poll_once_idle", "sigaction", 1, ns_per_op(start, kDispatchIterations));
+
+    sm.close_notify_fd();
+}
+
+double thread_cpu_s()
+{
+    ::timespec ts;
+    ::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) / 1e9;
+}
+
+double median(std::vector<double>& values)
+{
+    std::sort(values.begin(), values.end());
+    return values[values.size() / 2];
+}
+
+/// \brief  Slowdown of a compute loop sampled by the profiler at the frequency.
+///         After a warm-up run, baseline and profiled runs alternate, so a
+///         drift of the machine affects both; the median and the spread of
+///         the per-round slowdown are reported. Thread CPU timers are
+///         tick-granular, so the sample rate reached is reported as well.
+void profiler_overhead(std::size_t frequency)
+{
+    using wstux::signals::profiler;
+
+    const auto compute = []() -> double {
+        const clock_type::time_point start = clock_type::now();
+        for (std::size_t i = 0; i < kProfilerIterations; ++i) {
+            g_calls = g_calls + i;
+        }
+        return ns_per_op(start, kProfilerIterations);
+    };
+
+    wstux::signals::manager sm;
+    profiler::options opts;
+    opts.frequency = frequency;
+    profiler::start(sm, opts);
+    sm.threaded_signals_processing();
+
+    compute();
+    std::vector<double> base_ns;
+    std::vector<double> profiled_ns;
+    std::vector<double> overhead_pct;
+    double profiled_cpu_s = 0.0;
+    for (std::size_t round = 0; round < kProfilerRounds; ++round) {
+        base_ns.push_back(compute());
+        const double cpu_start = thread_cpu_s();
+        profiler::attach();
+        profiled_ns.push_back(compute());
+        profiler::detach();
+        profiled_cpu_s += thread_cpu_s() - cpu_start;
+        overhead_pct.push_back((profiled_ns.back() - base_ns.back()) * 100.0 / base_ns.back());
+    }
+    sm.stop_processing();
+    profiler::stop(sm);
+
+    const std::uint64_t samples = profiler::samples();
+    const double overhead_median = median(overhead_pct);
+    std::printf("{\"case\":\"profiler_overhead\",\"impl\":\"thread_cputime\",\"queue\":\"%s\",\"frequency\":%zu,"
+                "\"rounds\":%zu,\"samples\":%llu,\"sample_hz\":%.1f,\"base_ns_per_op\":%.3f,\"ns_per_op\":%.3f,"
+                "\"overhead_pct\":%.2f,\"overhead_min_pct\":%.2f,\"overhead_max_pct\":%.2f}\n",
+                kQueueName, frequency, kProfilerRounds, static_cast<unsigned long long>(samples),
+                static_cast<double>(samples) / profiled_cpu_s, median(base_ns), median(profiled_ns),
+                overhead_median, overhead_pct.front(), overhead_pct.back());
+    profiler::reset();
+}
+
+/// \brief  Time from sending a signal by 'kill' to the start of its handler on
+///         the processing thread.
+void wakeup_latency(wstux::signals::backend b)
+{
+    std::atomic<clock_type::rep> handled = {0};
+    wstux::signals::manager sm(b);
+    sm.set_handler(SIGUSR1, [&handled]() -> void {
+        handled.store(clock_type::now().time_since_epoch().count(), std::memory_order_release);
+    });
+    sm.threaded_signals_processing();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    std::vector<double> samples;
+    samples.reserve(kLatencyIterations);
+    for (std::size_t i = 0; i < kLatencyIterations; ++i) {
+        handled.store(0, std::memory_order_relaxed);
+        const clock_type::rep sent = clock_type::now().time_since_epoch().count();
+        ::kill(::getpid(), SIGUSR1);
+
+        clock_type::rep stamp;
+        while ((stamp = handled.load(std::memory_order_acquire)) == 0) {}
+        const std::chrono::duration<double, std::nano> latency = clock_type::duration(stamp - sent);
+        samples.push_back(latency.count());
+    }
+    sm.stop_processing();
+
+    report_latency("wakeup_latency", backend_name(b), samples);
+}
+
+} // <anonymous> namespace
+
+int main(int /*argc*/, char** /*argv*/)
+{
+    dispatch_table(1);
+    dispatch_table(64);
+    dispatch_burst(wstux::signals::backend::signalfd, 1);
+    dispatch_burst(wstux::signals::backend::signalfd, 64);
+    dispatch_burst(wstux::signals::backend::sigwait, 1);
+    dispatch_burst(wstux::signals::backend::sigwait, 64);
+    poll_idle();
+    profiler_overhead(99);
+    profiler_overhead(999);
+    queue_mpsc<sig_info_t>("siginfo", 1);
+    queue_mpsc<sig_info_t>("siginfo", 4);
+    queue_mpsc<wstux::signals::sig_record>("compact", 1);
+    queue_mpsc<wstux::signals::sig_record>("compact", 4);
+    queue_saturation(wstux::signals::overflow_policy::drop_newest);
+    queue_saturation(wstux::signals::overflow_policy::drop_oldest);
+    queue_saturation(wstux::signals::overflow_policy::coalesce);
+    sigqueue_throughput(wstux::signals::backend::sigaction, 1);
+    sigqueue_throughput(wstux::signals::backend::sigaction, 4);
+    sigqueue_throughput(wstux::signals::backend::signalfd, 4);
+    sigqueue_throughput(wstux::signals::backend::sigwait, 4);
+    wakeup_latency(wstux::signals::backend::sigaction);
+    wakeup_latency(wstux::signals::backend::signalfd);
+    wakeup_latency(wstux::signals::backend::sigwait);
+    return 0;
+}
@@ -0,0 +1,129 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2026 Chistyakov Alexander.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <unistd.h>
+
+#include <chrono>
+#include <csignal>
+#include <exception>
+#include <vector>
+
+#include <testing/testdefs.h>
+
+#include "signals/coroutine.h"
+
+namespace {
+
+struct detached_task
+{
+    struct promise_type
+    {
+        detached_task get_return_object() { return detached_task(); }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+detached_task await_records(wstux::signals::async_signals& as, wstux::signals::sig_num_t sig,
+                            std::vector<int>& values, std::size_t count)
+{
+    wstux::signals::async_signals::stream records = as.records(sig);
+    for (std::size_t i = 0; i < count; ++i) {
+        const wstux::signals::sig_info_t info = co_await records.next();
+        values.push_back(info.si_value.sival_int);
+    }
+}
+
+detached_task await_interleaved(wstux::signals::async_signals& as, wstux::signals::sig_num_t sig,
+                                wstux::signals::sig_num_t other, std::vector<int>& values)
+{
+    wstux::signals::async_signals::stream records = as.records(sig);
+    values.push_back((co_await records.next()).si_value.sival_int);
+    co_await as.next(other);
+    for (int i = 0; i < 2; ++i) {
+        values.push_back((co_await records.next()).si_value.sival_int);
+    }
+}
+
+} // <anonymous> namespace
+
+TEST(signals, coroutine)
+{
+    using namespace std::chrono_literals;
+    const int kSigRT = SIGRTMIN + 5;
+
+    wstux::signals::manager sm;
+    wstux::signals::async_signals as(sm, {kSigRT}, 2);
+    EXPECT_TRUE(as.is_installed());
+
+    // The coroutine is resumed by the processing loop.
+    std::vector<int> values;
+    await_records(as, kSigRT, values, 3);
+    EXPECT_TRUE(values.empty());
+    for (int i = 0; i < 6; ++i) {
+        ::sigqueue(::getpid(), kSigRT, ::sigval{i});
+    }
+    sm.signals_processing(100ms, true);
+    EXPECT_TRUE(values == std::vector<int>({0, 1, 2}));
+    EXPECT_TRUE(as.dropped(kSigRT) == 1);
+
+    // Buffered records are returned without suspending.
+    await_records(as, kSigRT, values, 2);
+    EXPECT_TRUE(values == std::vector<int>({0, 1, 2, 3, 4}));
+}
+
+TEST(signals, coroutine_stream_between_awaits)
+{
+    using namespace std::chrono_literals;
+    const int kSigRT = SIGRTMIN + 5;
+    const int kSigOther = SIGRTMIN + 6;
+
+    wstux::signals::manager sm;
+    wstux::signals::async_signals as(sm, {kSigRT, kSigOther});
+    EXPECT_TRUE(as.is_installed());
+
+    // The records received while the coroutine awaits the other signal are
+    // buffered by the stream.
+    std::vector<int> values;
+    await_interleaved(as, kSigRT, kSigOther, values);
+    for (int i = 0; i < 3; ++i) {
+        ::sigqueue(::getpid(), kSigRT, ::sigval{i});
+    }
+    sm.signals_processing(100ms, true);
+    EXPECT_TRUE(values == std::vector<int>({0}));
+    EXPECT_TRUE(as.records(kSigRT).buffered() == 2);
+
+    ::sigqueue(::getpid(), kSigOther, ::sigval{0});
+    sm.signals_processing(100ms, true);
+    EXPECT_TRUE(values == std::vector<int>({0, 1, 2}));
+    EXPECT_TRUE(as.records(kSigRT).buffered() == 0);
+    EXPECT_TRUE(as.dropped(kSigRT) == 0);
+}
+
+int main(int /*argc*/, char** /*argv*/)
+{
+    return RUN_ALL_TESTS();
+}
@@ -22,15 +22,31 @@
  * THE SOFTWARE.
  */
 
+#include <poll.h>
+#include <sched.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
 #include <csignal>
 #include <atomic>
+#include <fstream>
+#include <future>
 #include <iostream>
+#include <map>
+#include <memory>
 #include <mutex>
+#include <string>
 #include <thread>
+#include <vector>
 
 #include <testing/testdefs.h>
 
+#include "signals/child_reaper.h"
 #include "signals/manager.h"
+#include "signals/profiler.h"
+#include "signals/shutdown_orchestrator.h"
+#include "signals/static_manager.h"
+#include "signals/thread_signals.h"
 
 TEST(signals, basic)
 {
@@ -92,6 +108,82 @@ TEST(signals, threaded_signals_processing)
     EXPECT_TRUE(sm.is_stopped());
 }
 
+TEST(signals, thread_options)
+{
+    using namespace std::chrono_literals;
+
+    wstux::signals::manager::options opts;
+    opts.thread.cpus = {0};
+    opts.thread.name = "signals-processing";
+    opts.thread.lock_memory = true;
+    wstux::signals::manager sm(opts);
+
+    std::atomic_bool has_signal = {false};
+    std::string name;
+    int cpus = 0;
+    EXPECT_TRUE(sm.set_handler(SIGUSR1, [&]() -> void {
+        char buf[16] = {};
+        ::pthread_getname_np(::pthread_self(), buf, sizeof(buf));
+        name = buf;
+        ::cpu_set_t set;
+        ::sched_getaffinity(0, sizeof(set), &set);
+        cpus = CPU_COUNT(&set);
+        has_signal = true;
+    }));
+    EXPECT_TRUE(sm.threaded_signals_processing());
+    EXPECT_FALSE(sm.threaded_signals_processing());
+
+    std::this_thread::sleep_for(50ms);
+    ::kill(::getpid(), SIGUSR1);
+    for (int i = 0; (i < 100) && ! has_signal; ++i) {
+        std::this_thread::sleep_for(10ms);
+    }
+    sm.stop_processing();
+
+    EXPECT_TRUE(has_signal);
+    EXPECT_TRUE(name == "signals-process");
+    EXPECT_TRUE(cpus == 1);
+
+    opts.thread = wstux::signals::manager::thread_options();
+    opts.thread.policy = wstux::signals::sched_policy::fifo;
+    opts.thread.priority = 1000;
+    wstux::signals::manager invalid_sm(opts);
+    EXPECT_FALSE(invalid_sm.threaded_signals_processing());
+}
+
+TEST(signals, move_only_handler)
+{
+    wstux::signals::manager sm;
+    std::unique_ptr<int> p_value(new int(0));
+    int* p_raw = p_value.get();
+    EXPECT_TRUE(sm.set_handler(SIGUSR1, [&sm, p = std::move(p_value)]() -> void {
+        ++(*p);
+        sm.stop_processing();
+    }));
+
+    std::thread tr([&sm] { sm.signals_processing(); });
+    ::kill(::getpid(), SIGUSR1);
+    tr.join();
+    EXPECT_TRUE(*p_raw == 1);
+}
+
+TEST(signals, large_capture_handler)
+{
+    wstux::signals::manager sm;
+    std::string first(64, 'a');
+    std::string second(64, 'b');
+    std::string result;
+    EXPECT_TRUE(sm.set_handler(SIGUSR1, [&sm, &result, first, second]() -> void {
+        result = first + second;
+        sm.stop_processing();
+    }));
+
+    std::thread tr([&sm] { sm.signals_processing(); });
+    ::kill(::getpid(), SIGUSR1);
+    tr.join();
+    EXPECT_TRUE(result == std::string(64, 'a') + std::string(64, 'b'));
+}
+
 TEST(signals, timeout)
 {
     using namespace std::chrono_literals;
@@ -119,6 +211,38 @@ TEST(signals, change_handler_while_processing)
     tr.join();
 }
 
+TEST(signals, hot_swap_handler)
+{
+    using namespace std::chrono_literals;
+
+    for (wstux::signals::backend b : {wstux::signals::backend::sigaction, wstux::signals::backend::signalfd,
+                                      wstux::signals::backend::sigwait}) {
+        wstux::signals::manager sm(b);
+        std::atomic<int> value = {0};
+        EXPECT_TRUE(sm.set_handler(SIGUSR1, [&value]() -> void { value = 1; }));
+        sm.threaded_signals_processing();
+        std::this_thread::sleep_for(50ms);
+
+        ::kill(::getpid(), SIGUSR1);
+        while (value != 1) { std::this_thread::yield(); }
+
+        EXPECT_TRUE(sm.reset_handler(SIGUSR1, [&value]() -> void { value = 2; }));
+        ::kill(::getpid(), SIGUSR1);
+        while (value != 2) { std::this_thread::yield(); }
+
+        EXPECT_TRUE(sm.set_handler(SIGUSR2, [&value]() -> void { value = 3; }));
+        ::kill(::getpid(), SIGUSR2);
+        while (value != 3) { std::this_thread::yield(); }
+
+        sm.remove_handler(SIGUSR2);
+        EXPECT_TRUE(sm.set_handler(SIGUSR2, [&value]() -> void { value = 4; }));
+        ::kill(::getpid(), SIGUSR2);
+        while (value != 4) { std::this_thread::yield(); }
+
+        sm.stop_processing();
+    }
+}
+
 TEST(signals, reset_handler)
 {
     wstux::signals::manager sm;
@@ -130,6 +254,1070 @@ TEST(signals, reset_handler)
     tr.join();
 }
 
+TEST(signals, signalfd_basic)
+{
+    wstux::signals::manager sm(wstux::signals::backend::signalfd);
+    EXPECT_TRUE(sm.get_backend() == wstux::signals::backend::signalfd);
+    EXPECT_TRUE(sm.set_handler(SIGUSR1, [&sm]() -> void { sm.stop_processing(); }));
+
+    std::thread tr([&sm] { sm.signals_processing(); });
+    ::kill(::getpid(), SIGUSR1);
+    tr.join();
+}
+
+TEST(signals, signalfd_sigqueue)
+{
+    const int kSigRT = SIGRTMIN + 13;
+    const int kValue = 42;
+
+    wstux::signals::manager sm(wstux::signals::backend::signalfd);
+    int value = 0;
+    pid_t pid = 0;
+    EXPECT_TRUE(sm.set_handler(kSigRT, [&](wstux::signals::sig_num_t, const wstux::signals::sig_info_t& info) -> void {
+        value = info.si_value.sival_int;
+        pid = info.si_pid;
+        sm.stop_processing();
+    }));
+
+    std::thread tr([&sm] { sm.signals_processing(); } );
+    ::sigqueue(::getpid(), kSigRT, ::sigval{kValue});
+    tr.join();
+
+    EXPECT_TRUE(value == kValue);
+    EXPECT_TRUE(pid == ::getpid());
+}
+
+TEST(signals, signalfd_threaded_signals_processing)
+{
+    using namespace std::chrono_literals;
+
+    wstux::signals::manager sm(wstux::signals::backend::signalfd);
+    std::atomic_bool has_signal = {false};
+    std::mutex m;
+    m.lock();
+    EXPECT_TRUE(sm.set_handler(SIGUSR1, [&has_signal, &m]() -> void {
+        has_signal = true;
+        m.unlock();
+    }));
+
+    sm.threaded_signals_processing(200ms);
+
+    std::this_thread::sleep_for(200ms);
+    ::kill(::getpid(), SIGUSR1);
+
+    m.lock();
+    EXPECT_TRUE(has_signal);
+    m.unlock();
+
+    sm.stop_processing();
+    EXPECT_TRUE(sm.is_stopped());
+}
+
+TEST(signals, sigwait_basic)
+{
+    wstux::signals::manager sm(wstux::signals::backend::sigwait);
+    EXPECT_TRUE(sm.get_backend() == wstux::signals::backend::sigwait);
+    EXPECT_TRUE(sm.set_handler(SIGUSR1, [&sm]() -> void { sm.stop_processing(); }));
+
+    std::thread tr([&sm] { sm.signals_processing(); });
+    ::kill(::getpid(), SIGUSR1);
+    tr.join();
+}
+
+TEST(signals, sigwait_sigqueue)
+{
+    using namespace std::chrono_literals;
+    const int kSigRT = SIGRTMIN + 13;
+
+    wstux::signals::manager sm(wstux::signals::backend::sigwait);
+    std::vector<int> values;
+    EXPECT_TRUE(sm.set_handler(kSigRT, [&values](wstux::signals::sig_num_t, const wstux::signals::sig_info_t& info) -> void {
+        values.push_back(info.si_value.sival_int);
+    }));
+    for (int i = 0; i < 5; ++i) {
+        ::sigqueue(::getpid(), kSigRT, ::sigval{i});
+    }
+    sm.signals_processing(100ms, true);
+
+    EXPECT_TRUE(values.size() == 5);
+    for (int i = 0; i < (int)values.size(); ++i) {
+        EXPECT_TRUE(values[i] == i);
+    }
+}
+
+TEST(signals, sigwait_timeout)
+{
+    using namespace std::chrono_literals;
+
+    wstux::signals::manager sm(wstux::signals::backend::sigwait);
+    bool has_signal = false;
+    EXPECT_TRUE(sm.set_handler(SIGUSR1, [&has_signal]() -> void { has_signal = true; }));
+
+    const std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    sm.signals_processing(50ms, true);
+    EXPECT_TRUE(std::chrono::steady_clock::now() - begin >= 50ms);
+    EXPECT_FALSE(has_signal);
+}
+
+TEST(signals, sigwait_wake_keeps_signal)
+{
+    using namespace std::chrono_literals;
+
+    wstux::signals::manager sm(wstux::signals::backend::sigwait);
+    std::atomic<int> received = {0};
+    std::promise<::pthread_t> busy;
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::atomic_bool is_first = {true};
+    EXPECT_TRUE(sm.set_handler(SIGUSR1, [&received]() -> void { ++received; }));
+    EXPECT_TRUE(sm.set_handler(SIGUSR2, [&]() -> void {
+        if (is_first.exchange(false)) {
+            busy.set_value(::pthread_self());
+            released.wait();
+        }
+    }));
+    sm.threaded_signals_processing();
+
+    // The processing thread is busy, so the wakeup sent by a signal handled
+    // in another thread is still pending when a signal is directed to it.
+    ::kill(::getpid(), SIGUSR2);
+    const ::pthread_t processing_thread = busy.get_future().get();
+    std::thread([processing_thread]() -> void {
+        ::sigset_t set;
+        ::sigemptyset(&set);
+        ::sigaddset(&set, SIGUSR2);
+        ::pthread_sigmask(SIG_UNBLOCK, &set, nullptr);
+        ::raise(SIGUSR2);
+        ::pthread_kill(processing_thread, SIGUSR1);
+    }).join();
+    release.set_value();
+
+    const auto deadline = std::chrono::steady_clock::now() + 2s;
+    while ((received == 0) && (std::chrono::steady_clock::now() < deadline)) {
+        std::this_thread::sleep_for(1ms);
+    }
+    sm.stop_processing();
+    EXPECT_TRUE(received == 1);
+}
+
+TEST(signals, sigwait_threaded_signals_processing)
+{
+    using namespace std::chrono_literals;
+
+    wstux::signals::manager sm(wstux::signals::backend::sigwait);
+    std::atomic_bool has_signal = {false};
+    std::mutex m;
+    m.lock();
+    EXPECT_TRUE(sm.set_handler(SIGUSR1, [&has_signal, &m]() -> void {
+        has_signal = true;
+        m.unlock();
+    }));
+
+    sm.threaded_signals_processing();
+
+    std::this_thread::sleep_for(200ms);
+    ::kill(::getpid(), SIGUSR1);
+
+    m.lock();
+    EXPECT_TRUE(has_signal);
+    m.unlock();
+
+    sm.stop_processing();
+    EXPECT_TRUE(sm.is_stopped());
+}
+
+TEST(signals, notify_fd)
+{
+    using namespace std::chrono_literals;
+    const int kSigRT = SIGRTMIN + 3;
+
+    for (wstux::signals::backend b : {wstux::signals::backend::sigaction, wstux::signals::backend::signalfd}) {
+        wstux::signals::manager sm(b);
+        std::vector<int> values;
+        EXPECT_TRUE(sm.set_handler(kSigRT, [&values](wstux::signals::sig_num_t, const wstux::signals::sig_info_t& info) -> void {
+            values.push_back(info.si_value.sival_int);
+        }));
+
+        const int fd = sm.open_notify_fd();
+        EXPECT_TRUE(fd >= 0);
+        EXPECT_TRUE(sm.open_notify_fd() == fd);
+
+        ::pollfd pfd = {fd, POLLIN, 0};
+        EXPECT_TRUE(::poll(&pfd, 1, 0) == 0);
+        EXPECT_TRUE(sm.dispatch_pending() == 0);
+
+        for (int i = 0; i < 3; ++i) {
+            ::sigqueue(::getpid(), kSigRT, ::sigval{i});
+        }
+        EXPECT_TRUE(::poll(&pfd, 1, 1000) == 1);
+        EXPECT_TRUE(sm.dispatch_pending(2) == 2);
+        EXPECT_TRUE(::poll(&pfd, 1, 0) == 1);
+        EXPECT_TRUE(sm.dispatch_pending() == 1);
+        EXPECT_TRUE(::poll(&pfd, 1, 0) == 0);
+        EXPECT_TRUE((values.size() == 3) && (values[0] == 0) && (values[1] == 1) && (values[2] == 2));
+
+        bool has_signal = false;
+        EXPECT_TRUE(sm.set_handler(SIGUSR2, [&has_signal]() -> void { has_signal = true; }));
+        ::kill(::getpid(), SIGUSR2);
+        EXPECT_TRUE(sm.dispatch_pending() == 1);
+        EXPECT_TRUE(has_signal);
+
+        sm.close_notify_fd();
+    }
+}
+
+TEST(signals, poll_once)
+{
+    wstux::signals::manager sm(wstux::signals::backend::sigaction);
+    std::size_t usr1_count = 0;
+    std::size_t usr2_count = 0;
+    EXPECT_TRUE(sm.set_handler(SIGUSR1, [&usr1_count]() -> void { ++usr1_count; }));
+    EXPECT_TRUE(sm.set_handler(SIGUSR2, [&usr2_count](wstux::signals::sig_num_t, std::size_t count) -> void {
+        usr2_count += count;
+    }));
+    EXPECT_TRUE(sm.poll_once() == 0);
+
+    EXPECT_TRUE(sm.open_notify_fd() >= 0);
+    EXPECT_TRUE(sm.poll_once() == 0);
+
+    ::kill(::getpid(), SIGUSR1);
+    ::kill(::getpid(), SIGUSR2);
+    EXPECT_TRUE(sm.poll_once() == 2);
+    EXPECT_TRUE((usr1_count == 1) && (usr2_count == 1));
+    EXPECT_TRUE(sm.poll_once() == 0);
+}
+
+TEST(signals, notify_fd_sigwait)
+{
+    wstux::signals::manager sm(wstux::signals::backend::sigwait);
+    EXPECT_TRUE(sm.set_handler(SIGUSR1, []() -> void {}));
+    EXPECT_TRUE(sm.open_notify_fd() < 0);
+}
+
+TEST(signals, overflow_drop_newest)
+{
+    using namespace std::chrono_literals;
+    const int kSigRT = SIGRTMIN + 1;
+
+    wstux::signals::manager::options opts;
+    opts.delivery = wstux::signals::backend::sigaction;
+    opts.queue_capacity = 2;
+    opts.overflow = wstux::signals::overflow_policy::drop_newest;
+    wstux::signals::manager sm(opts);
+    EXPECT_TRUE(sm.queue_capacity() == 2);
+
+    std::vector<int> values;
+    EXPECT_TRUE(sm.set_handler(kSigRT, [&values](wstux::signals::sig_num_t, const wstux::signals::sig_info_t& info) -> void {
+        values.push_back(info.si_value.sival_int);
+    }));
+    for (int i = 0; i < 5; ++i) {
+        ::sigqueue(::getpid(), kSigRT, ::sigval{i});
+    }
+    sm.signals_processing(100ms, true);
+
+    EXPECT_TRUE((values.size() == 2) && (values[0] == 0) && (values[1] == 1));
+    EXPECT_TRUE(sm.dropped(kSigRT) == 3);
+    EXPECT_TRUE(sm.coalesced(kSigRT) == 0);
+}
+
+TEST(signals, overflow_drop_oldest)
+{
+    using namespace std::chrono_literals;
+    const int kSigRT = SIGRTMIN + 1;
+
+    wstux::signals::manager::options opts;
+    opts.delivery = wstux::signals::backend::sigaction;
+    opts.queue_capacity = 2;
+    opts.overflow = wstux::signals::overflow_policy::drop_oldest;
+    wstux::signals::manager sm(opts);
+
+    std::vector<int> values;
+    EXPECT_TRUE(sm.set_handler(kSigRT, [&values](wstux::signals::sig_num_t, const wstux::signals::sig_info_t& info) -> void {
+        values.push_back(info.si_value.sival_int);
+    }));
+    for (int i = 0; i < 5; ++i) {
+        ::sigqueue(::getpid(), kSigRT, ::sigval{i});
+    }
+    sm.signals_processing(100ms, true);
+
+    EXPECT_TRUE((values.size() == 2) && (values[0] == 3) && (values[1] == 4));
+    EXPECT_TRUE(sm.dropped(kSigRT) == 3);
+}
+
+TEST(signals, overflow_coalesce)
+{
+    using namespace std::chrono_literals;
+    const int kSigRT = SIGRTMIN + 1;
+
+    wstux::signals::manager::options opts;
+    opts.delivery = wstux::signals::backend::sigaction;
+    opts.queue_capacity = 2;
+    opts.overflow = wstux::signals::overflow_policy::coalesce;
+    wstux::signals::manager sm(opts);
+
+    int count = 0;
+    EXPECT_TRUE(sm.set_handler(kSigRT, [&count]() -> void { ++count; }));
+    for (int i = 0; i < 5; ++i) {
+        ::sigqueue(::getpid(), kSigRT, ::sigval{i});
+    }
+    sm.signals_processing(100ms, true);
+
+    EXPECT_TRUE(count == 2);
+    EXPECT_TRUE(sm.coalesced(kSigRT) == 3);
+    EXPECT_TRUE(sm.dropped(kSigRT) == 0);
+}
+
+TEST(signals, coalesced_handler)
+{
+    using namespace std::chrono_literals;
+
+    wstux::signals::manager sm(wstux::signals::backend::sigaction);
+    std::size_t usr1_count = 0;
+    std::size_t usr2_count = 0;
+    EXPECT_TRUE(sm.set_handler(SIGUSR1, [&usr1_count](wstux::signals::sig_num_t, std::size_t count) -> void {
+        usr1_count += count;
+    }));
+    EXPECT_TRUE(sm.set_handler(SIGUSR2, [&usr2_count](wstux::signals::sig_num_t, std::size_t count) -> void {
+        usr2_count += count;
+    }));
+    EXPECT_FALSE(sm.set_handler(SIGUSR1, []() -> void {}));
+    EXPECT_FALSE(sm.set_handler(SIGRTMIN + 1, [](wstux::signals::sig_num_t, std::size_t) -> void {}));
+
+    ::kill(::getpid(), SIGUSR1);
+    ::kill(::getpid(), SIGUSR2);
+    sm.signals_processing(100ms, true);
+
+    EXPECT_TRUE(usr1_count == 1);
+    EXPECT_TRUE(usr2_count == 1);
+}
+
+TEST(signals, signalfd_coalesced_handler)
+{
+    wstux::signals::manager sm(wstux::signals::backend::signalfd);
+    std::size_t usr1_count = 0;
+    EXPECT_TRUE(sm.set_handler(SIGUSR1, [&](wstux::signals::sig_num_t, std::size_t count) -> void {
+        usr1_count += count;
+        sm.stop_processing();
+    }));
+
+    std::thread tr([&sm] { sm.signals_processing(); } );
+    ::kill(::getpid(), SIGUSR1);
+    tr.join();
+
+    EXPECT_TRUE(usr1_count == 1);
+}
+
+TEST(signals, batch_handler)
+{
+    using namespace std::chrono_literals;
+    const int kSigRT = SIGRTMIN + 3;
+
+    for (wstux::signals::backend b : {wstux::signals::backend::sigaction, wstux::signals::backend::signalfd}) {
+        wstux::signals::manager sm(b);
+        std::size_t calls = 0;
+        std::vector<int> values;
+        EXPECT_TRUE(sm.set_batch_handler(kSigRT, [&](wstux::signals::sig_num_t, const wstux::signals::sig_info_t* p_infos, std::size_t count) -> void {
+            ++calls;
+            for (std::size_t i = 0; i < count; ++i) {
+                values.push_back(p_infos[i].si_value.sival_int);
+            }
+        }));
+        EXPECT_FALSE(sm.set_handler(kSigRT, []() -> void {}));
+
+        for (int i = 0; i < 5; ++i) {
+            ::sigqueue(::getpid(), kSigRT, ::sigval{i});
+        }
+        sm.signals_processing(100ms, true);
+
+        EXPECT_TRUE(calls == 1);
+        EXPECT_TRUE(values == std::vector<int>({0, 1, 2, 3, 4}));
+    }
+}
+
+TEST(signals, compact_handler)
+{
+    using namespace std::chrono_literals;
+    const int kSigRT = SIGRTMIN + 3;
+
+    for (wstux::signals::backend b : {wstux::signals::backend::sigaction, wstux::signals::backend::signalfd}) {
+        wstux::signals::manager sm(b);
+        std::vector<int> values;
+        EXPECT_TRUE(sm.set_handler(kSigRT, [&values](wstux::signals::sig_num_t sig, const wstux::signals::sig_record& record) -> void {
+            EXPECT_TRUE((sig == record.signo) && (record.code == SI_QUEUE) && (record.pid == ::getpid()));
+            values.push_back(record.value.sival_int);
+        }));
+
+        for (int i = 0; i < 3; ++i) {
+            ::sigqueue(::getpid(), kSigRT, ::sigval{i});
+        }
+        sm.signals_processing(100ms, true);
+        EXPECT_TRUE(values == std::vector<int>({0, 1, 2}));
+
+        // Records queued for the full handler are passed to the compact one
+        // and vice versa.
+        std::vector<int> full_values;
+        EXPECT_TRUE(sm.reset_handler(kSigRT, [&full_values](wstux::signals::sig_num_t, const wstux::signals::sig_info_t& info) -> void {
+            full_values.push_back(info.si_value.sival_int);
+        }));
+        ::sigqueue(::getpid(), kSigRT, ::sigval{3});
+        values.clear();
+        EXPECT_TRUE(sm.reset_handler(kSigRT, [&values](wstux::signals::sig_num_t, const wstux::signals::sig_record& record) -> void {
+            values.push_back(record.value.sival_int);
+        }));
+        ::sigqueue(::getpid(), kSigRT, ::sigval{4});
+        sm.signals_processing(100ms, true);
+
+        EXPECT_TRUE(full_values.empty());
+        EXPECT_TRUE(values == std::vector<int>({3, 4}));
+    }
+}
+
+TEST(signals, workers)
+{
+    using namespace std::chrono_literals;
+    const int kSigRT = SIGRTMIN + 7;
+
+    wstux::signals::manager::options opts;
+    opts.workers = 2;
+    wstux::signals::manager sm(opts);
+
+    std::mutex m;
+    std::vector<int> values;
+    std::atomic<std::size_t> slow_count = {0};
+    std::atomic<std::size_t> slow_count_at_fast = {0};
+    EXPECT_TRUE(sm.set_handler(kSigRT, [&](wstux::signals::sig_num_t, const wstux::signals::sig_info_t& info) -> void {
+        std::this_thread::sleep_for(20ms);
+        std::lock_guard<std::mutex> lock(m);
+        values.push_back(info.si_value.sival_int);
+        ++slow_count;
+    }));
+    EXPECT_TRUE(sm.set_handler(SIGUSR1, [&]() -> void { slow_count_at_fast = slow_count.load(); }));
+
+    for (int i = 0; i < 3; ++i) {
+        ::sigqueue(::getpid(), kSigRT, ::sigval{i});
+    }
+    ::kill(::getpid(), SIGUSR1);
+    sm.signals_processing(100ms, true);
+    sm.clear();
+
+    EXPECT_TRUE((values.size() == 3) && (values[0] == 0) && (values[1] == 1) && (values[2] == 2));
+    EXPECT_TRUE(slow_count_at_fast < 3);
+}
+
+TEST(signals, workers_priority)
+{
+    using namespace std::chrono_literals;
+    const int kSigRT = SIGRTMIN + 7;
+
+    wstux::signals::manager::options opts;
+    opts.workers = 1;
+    wstux::signals::manager sm(opts);
+
+    std::mutex m;
+    std::vector<int> order;
+    EXPECT_TRUE(sm.set_handler(kSigRT, [&](wstux::signals::sig_num_t, const wstux::signals::sig_info_t& info) -> void {
+        std::this_thread::sleep_for(20ms);
+        std::lock_guard<std::mutex> lock(m);
+        order.push_back(info.si_value.sival_int);
+    }, wstux::signals::priority::low));
+    EXPECT_TRUE(sm.set_handler(SIGTERM, [&]() -> void {
+        std::lock_guard<std::mutex> lock(m);
+        order.push_back(-1);
+    }, wstux::signals::priority::critical));
+
+    for (int i = 0; i < 3; ++i) {
+        ::sigqueue(::getpid(), kSigRT, ::sigval{i});
+    }
+    ::kill(::getpid(), SIGTERM);
+    sm.signals_processing(100ms, true);
+    sm.clear();
+
+    EXPECT_TRUE(order.size() == 4);
+    EXPECT_TRUE((order[0] == -1) || (order[1] == -1));
+}
+
+TEST(signals, priority_order)
+{
+    using namespace std::chrono_literals;
+    const int kSigBulk = SIGRTMIN + 1;
+    const int kSigCritical = SIGRTMIN + 9;
+
+    for (wstux::signals::backend b : {wstux::signals::backend::sigaction, wstux::signals::backend::signalfd,
+                                      wstux::signals::backend::sigwait}) {
+        wstux::signals::manager sm(b);
+        std::vector<int> order;
+        EXPECT_TRUE(sm.set_handler(kSigBulk, [&order](wstux::signals::sig_num_t, const wstux::signals::sig_info_t& info) -> void {
+            order.push_back(info.si_value.sival_int);
+        }));
+        EXPECT_TRUE(sm.set_handler(kSigCritical, [&order]() -> void { order.push_back(-1); },
+                                   wstux::signals::priority::critical));
+
+        for (int i = 0; i < 10; ++i) {
+            ::sigqueue(::getpid(), kSigBulk, ::sigval{i});
+            if (i == 5) {
+                ::kill(::getpid(), kSigCritical);
+            }
+        }
+        sm.signals_processing(100ms, true);
+
+        EXPECT_TRUE((order.size() == 11) && (order[0] == -1));
+        for (int i = 1; i < (int)order.size(); ++i) {
+            EXPECT_TRUE(order[i] == i - 1);
+        }
+    }
+}
+
+TEST(signals, rate_limit)
+{
+    using namespace std::chrono_literals;
+    const int kSigRT = SIGRTMIN + 4;
+
+    for (wstux::signals::backend b : {wstux::signals::backend::sigaction, wstux::signals::backend::signalfd}) {
+        wstux::signals::manager sm(b);
+        std::vector<int> values;
+        const auto handler = [&values](wstux::signals::sig_num_t, const wstux::signals::sig_info_t& info) -> void {
+            values.push_back(info.si_value.sival_int);
+        };
+        EXPECT_FALSE(sm.set_handler(kSigRT, handler, wstux::signals::rate_limit::throttle(0ms)));
+        EXPECT_FALSE(sm.set_handler(kSigRT, handler, wstux::signals::rate_limit::debounce(50ms, false, false)));
+
+        // Throttle calls the handler with the first record and with the last
+        // one at the end of the interval.
+        EXPECT_TRUE(sm.set_handler(kSigRT, handler, wstux::signals::rate_limit::throttle(50ms)));
+        for (int i = 0; i < 5; ++i) {
+            ::sigqueue(::getpid(), kSigRT, ::sigval{i});
+        }
+        sm.signals_processing(100ms, true);
+        EXPECT_TRUE(values == std::vector<int>({0}));
+        // Processing wakes up on the remaining semaphore posts before the
+        // deadline, so it is repeated until the trailing call.
+        const auto process_until = [&sm, &values](std::size_t count) -> void {
+            const auto deadline = std::chrono::steady_clock::now() + 1s;
+            while ((values.size() < count) && (std::chrono::steady_clock::now() < deadline)) {
+                sm.signals_processing(100ms, true);
+            }
+        };
+        process_until(2);
+        EXPECT_TRUE(values == std::vector<int>({0, 4}));
+
+        // Debounce calls the handler once the burst is over.
+        values.clear();
+        EXPECT_TRUE(sm.reset_handler(kSigRT, handler, wstux::signals::rate_limit::debounce(50ms)));
+        for (int i = 0; i < 3; ++i) {
+            ::sigqueue(::getpid(), kSigRT, ::sigval{i});
+        }
+        sm.signals_processing(100ms, true);
+        EXPECT_TRUE(values.empty());
+        process_until(1);
+        EXPECT_TRUE(values == std::vector<int>({2}));
+    }
+}
+
+TEST(signals, rate_limit_notify_fd)
+{
+    using namespace std::chrono_literals;
+    const int kSigRT = SIGRTMIN + 4;
+
+    for (wstux::signals::backend b : {wstux::signals::backend::sigaction, wstux::signals::backend::signalfd}) {
+        wstux::signals::manager sm(b);
+        std::vector<int> values;
+        const auto handler = [&values](wstux::signals::sig_num_t, const wstux::signals::sig_info_t& info) -> void {
+            values.push_back(info.si_value.sival_int);
+        };
+        EXPECT_TRUE(sm.set_handler(kSigRT, handler, wstux::signals::rate_limit::debounce(50ms)));
+        const int fd = sm.open_notify_fd();
+        EXPECT_TRUE(fd >= 0);
+
+        // The descriptor becomes readable at the debounce deadline without
+        // another signal.
+        for (int i = 0; i < 3; ++i) {
+            ::sigqueue(::getpid(), kSigRT, ::sigval{i});
+        }
+        ::pollfd pfd = {fd, POLLIN, 0};
+        EXPECT_TRUE(::poll(&pfd, 1, 1000) == 1);
+        sm.dispatch_pending();
+        EXPECT_TRUE(values.empty());
+        EXPECT_TRUE(::poll(&pfd, 1, 1000) == 1);
+        sm.dispatch_pending();
+        EXPECT_TRUE(values == std::vector<int>({2}));
+        EXPECT_TRUE(::poll(&pfd, 1, 0) == 0);
+
+        // Polling makes the trailing throttle call once its deadline is due.
+        values.clear();
+        EXPECT_TRUE(sm.reset_handler(kSigRT, handler, wstux::signals::rate_limit::throttle(50ms)));
+        for (int i = 0; i < 3; ++i) {
+            ::sigqueue(::getpid(), kSigRT, ::sigval{i});
+        }
+        const auto deadline = std::chrono::steady_clock::now() + 1s;
+        while ((values.size() < 2) && (std::chrono::steady_clock::now() < deadline)) {
+            sm.poll_once();
+        }
+        EXPECT_TRUE(values == std::vector<int>({0, 2}));
+
+        sm.close_notify_fd();
+    }
+}
+
+TEST(signals, timers)
+{
+    using namespace std::chrono_literals;
+    using wstux::signals::manager;
+
+    for (wstux::signals::backend b : {wstux::signals::backend::sigaction, wstux::signals::backend::signalfd,
+                                      wstux::signals::backend::sigwait}) {
+        manager sm(b);
+        std::size_t oneshot_count = 0;
+        std::size_t expirations = 0;
+        EXPECT_TRUE(sm.set_timer(1ms, [&oneshot_count]() -> void { ++oneshot_count; }) != manager::invalid_timer);
+        const manager::timer_id_t id = sm.set_timer(2ms, [&expirations](std::size_t count) -> void {
+            expirations += count;
+        }, 2ms);
+        EXPECT_TRUE(id != manager::invalid_timer);
+        // The timer signal is owned by the timers.
+        EXPECT_FALSE(sm.set_handler(SIGRTMAX, []() -> void {}));
+
+        const auto deadline = std::chrono::steady_clock::now() + 1s;
+        while (((expirations < 5) || (oneshot_count == 0)) && (std::chrono::steady_clock::now() < deadline)) {
+            sm.signals_processing(100ms, true);
+        }
+        EXPECT_TRUE(oneshot_count == 1);
+        EXPECT_TRUE(expirations >= 5);
+
+        EXPECT_TRUE(sm.cancel_timer(id));
+        EXPECT_FALSE(sm.cancel_timer(id));
+        EXPECT_FALSE(sm.cancel_timer(manager::invalid_timer));
+        const std::size_t cancelled_expirations = expirations;
+        sm.signals_processing(10ms, true);
+        EXPECT_TRUE(expirations == cancelled_expirations);
+    }
+}
+
+TEST(signals, child_reaper)
+{
+    using namespace std::chrono_literals;
+
+    wstux::signals::manager sm;
+    wstux::signals::child_reaper reaper(sm);
+    EXPECT_TRUE(reaper.is_installed());
+
+    std::map<::pid_t, int> codes;
+    const auto on_exit = [&codes](const wstux::signals::child_exit& child) -> void {
+        EXPECT_TRUE(WIFEXITED(child.status));
+        codes[child.pid] = WEXITSTATUS(child.status);
+    };
+    std::map<::pid_t, int> expected;
+    for (int i = 0; i < 8; ++i) {
+        const ::pid_t pid = ::fork();
+        if (pid == 0) {
+            ::_exit(i);
+        }
+        expected[pid] = i;
+        EXPECT_TRUE(reaper.watch(pid, on_exit));
+    }
+    EXPECT_FALSE(reaper.watch(0, on_exit));
+    EXPECT_FALSE(reaper.watch(::getpid(), on_exit));
+    EXPECT_FALSE(reaper.watch(expected.begin()->first, on_exit));
+
+    const auto deadline = std::chrono::steady_clock::now() + 1s;
+    while ((codes.size() < expected.size()) && (std::chrono::steady_clock::now() < deadline)) {
+        sm.signals_processing(100ms, true);
+    }
+    EXPECT_TRUE(codes == expected);
+    EXPECT_TRUE(reaper.watched() == 0);
+
+    // The exit of a child reaped before it is watched is kept.
+    const ::pid_t pid = ::fork();
+    if (pid == 0) {
+        ::_exit(42);
+    }
+    ::usleep(10000);
+    sm.signals_processing(100ms, true);
+    EXPECT_TRUE(reaper.watch(pid, on_exit));
+    EXPECT_TRUE(codes[pid] == 42);
+}
+
+TEST(signals, child_reaper_recycled_pid)
+{
+    using namespace std::chrono_literals;
+
+    wstux::signals::manager sm;
+    wstux::signals::child_reaper reaper(sm);
+
+    // The exit of an unwatched child is kept.
+    const ::pid_t first = ::fork();
+    if (first == 0) {
+        ::_exit(3);
+    }
+    ::usleep(10000);
+    sm.signals_processing(100ms, true);
+
+    // The pid is recycled by a new child through 'ns_last_pid'.
+    int fds[2];
+    EXPECT_TRUE(::pipe(fds) == 0);
+    ::pid_t second = 0;
+    for (int attempt = 0; (attempt < 10) && (second != first); ++attempt) {
+        std::ofstream last_pid("/proc/sys/kernel/ns_last_pid");
+        if (! (last_pid << (first - 1) << std::flush)) {
+            break;
+        }
+        last_pid.close();
+        second = ::fork();
+        if (second == 0) {
+            char c;
+            ::close(fds[1]);
+            ::_exit((::read(fds[0], &c, 1) == 0) ? 5 : 1);
+        }
+    }
+    ::close(fds[0]);
+    if (second != first) {
+        ::close(fds[1]);
+        std::cout << "The pid can not be recycled, the test is skipped" << std::endl;
+        return;
+    }
+
+    // The exit of the predecessor is not passed to the new child's callback.
+    std::map<::pid_t, int> codes;
+    EXPECT_TRUE(reaper.watch(second, [&codes](const wstux::signals::child_exit& child) -> void {
+        codes[child.pid] = WEXITSTATUS(child.status);
+    }));
+    EXPECT_TRUE(codes.empty());
+
+    ::close(fds[1]);
+    const auto deadline = std::chrono::steady_clock::now() + 1s;
+    while (codes.empty() && (std::chrono::steady_clock::now() < deadline)) {
+        sm.signals_processing(100ms, true);
+    }
+    EXPECT_TRUE((codes.size() == 1) && (codes[second] == 5));
+}
+
+TEST(signals, shutdown_orchestrator)
+{
+    using namespace std::chrono_literals;
+
+    wstux::signals::manager sm;
+    wstux::signals::shutdown_orchestrator so(sm);
+    EXPECT_TRUE(so.is_installed());
+    EXPECT_TRUE(so.add_phase("stop_accepting", 0ms));
+    EXPECT_TRUE(so.add_phase("drain", 50ms));
+    EXPECT_TRUE(so.add_phase("flush", 5000ms));
+    EXPECT_FALSE(so.add_phase("drain", 10ms));
+    EXPECT_FALSE(so.add_hook("close", []() -> void {}));
+
+    std::atomic<std::size_t> stopped = {0};
+    for (int i = 0; i < 2; ++i) {
+        EXPECT_TRUE(so.add_hook("stop_accepting", [&stopped]() -> void {
+            std::this_thread::sleep_for(20ms);
+            ++stopped;
+        }));
+    }
+    EXPECT_TRUE(so.add_hook("drain", []() -> void { std::this_thread::sleep_for(500ms); }));
+    EXPECT_TRUE(so.add_hook("flush", []() -> void { std::this_thread::sleep_for(1000ms); }));
+
+    // The second signal ends the flush phase.
+    std::thread escalator([&so]() -> void {
+        while (so.report().size() < 2) {
+            std::this_thread::sleep_for(1ms);
+        }
+        ::kill(::getpid(), SIGTERM);
+    });
+    ::kill(::getpid(), SIGTERM);
+    sm.signals_processing();
+    escalator.join();
+    so.wait();
+
+    const std::vector<wstux::signals::shutdown_phase_report> reports = so.report();
+    EXPECT_TRUE(so.is_done());
+    EXPECT_TRUE(stopped == 2);
+    EXPECT_TRUE(reports.size() == 3);
+    EXPECT_TRUE((reports[0].name == "stop_accepting") && (reports[0].unfinished == 0));
+    EXPECT_TRUE((reports[1].unfinished == 1) && reports[1].is_timed_out);
+    EXPECT_TRUE((reports[2].unfinished == 1) && reports[2].is_escalated && ! reports[2].is_timed_out);
+    EXPECT_FALSE(so.request());
+}
+
+TEST(signals, shutdown_orchestrator_repeated_signal)
+{
+    using namespace std::chrono_literals;
+
+    wstux::signals::manager sm;
+    wstux::signals::shutdown_orchestrator so(sm);
+    EXPECT_TRUE(so.add_phase("drain", 5000ms));
+    EXPECT_TRUE(so.add_hook("drain", []() -> void { std::this_thread::sleep_for(1000ms); }));
+
+    // Both signals are handled in this thread before the processing starts,
+    // so the orchestrator receives them in one wakeup.
+    ::sigset_t set;
+    ::sigemptyset(&set);
+    ::sigaddset(&set, SIGTERM);
+    ::pthread_sigmask(SIG_UNBLOCK, &set, nullptr);
+    ::kill(::getpid(), SIGTERM);
+    ::kill(::getpid(), SIGTERM);
+    ::pthread_sigmask(SIG_BLOCK, &set, nullptr);
+
+    sm.signals_processing();
+    so.wait();
+
+    const std::vector<wstux::signals::shutdown_phase_report> reports = so.report();
+    EXPECT_TRUE(reports.size() == 1);
+    EXPECT_TRUE((reports[0].unfinished == 1) && reports[0].is_escalated && ! reports[0].is_timed_out);
+}
+
+TEST(signals, thread_signals)
+{
+    using namespace std::chrono_literals;
+    using wstux::signals::thread_signals;
+    const int kSigRT = SIGRTMIN + 10;
+
+    EXPECT_FALSE(thread_signals::attach());
+    EXPECT_TRUE(thread_signals::set_signal(kSigRT));
+
+    int fds[2];
+    EXPECT_TRUE(::pipe(fds) == 0);
+    std::promise<wstux::signals::thread_handle> attached;
+    std::uint32_t received = 0;
+    std::chrono::steady_clock::duration wait_time;
+    std::thread worker([&]() -> void {
+        EXPECT_TRUE(thread_signals::attach([&received](std::uint32_t bits) -> void { received |= bits; }));
+        EXPECT_FALSE(thread_signals::attach());
+        attached.set_value(thread_signals::self());
+
+        // The blocking call is interrupted by the directed signal.
+        const auto start = std::chrono::steady_clock::now();
+        ::pollfd pfd = {fds[0], POLLIN, 0};
+        while (thread_signals::dispatch() == 0) {
+            ::poll(&pfd, 1, 5000);
+        }
+        wait_time = std::chrono::steady_clock::now() - start;
+        thread_signals::detach();
+    });
+
+    const wstux::signals::thread_handle handle = attached.get_future().get();
+    EXPECT_TRUE(handle.is_valid());
+    std::this_thread::sleep_for(20ms);
+    EXPECT_TRUE(thread_signals::send(handle, 0x5));
+    worker.join();
+    EXPECT_TRUE(received == 0x5);
+    EXPECT_TRUE(wait_time < 2s);
+
+    // The detached thread is not addressed anymore.
+    EXPECT_FALSE(thread_signals::send(handle, 0x1));
+
+    // The handle of the previous attachment of the same thread and mailbox
+    // is stale.
+    EXPECT_TRUE(thread_signals::attach());
+    const wstux::signals::thread_handle first = thread_signals::self();
+    thread_signals::detach();
+    EXPECT_TRUE(thread_signals::attach());
+    const wstux::signals::thread_handle second = thread_signals::self();
+    EXPECT_TRUE((first.slot == second.slot) && (first.tid == second.tid));
+    EXPECT_FALSE(thread_signals::send(first, 0x1));
+    EXPECT_FALSE(thread_signals::is_pending());
+    EXPECT_TRUE(thread_signals::send(second, 0x2));
+    EXPECT_TRUE(thread_signals::dispatch() == 0x2);
+    thread_signals::detach();
+    thread_signals::reset_signal();
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+TEST(signals, profiler)
+{
+    using namespace std::chrono_literals;
+    using wstux::signals::profiler;
+
+    wstux::signals::manager sm;
+    profiler::options opts;
+    opts.frequency = 1000;
+    opts.aggregation_period = 10ms;
+    EXPECT_FALSE(profiler::attach());
+    EXPECT_TRUE(profiler::start(sm, opts));
+    EXPECT_FALSE(profiler::start(sm, opts));
+    EXPECT_TRUE(profiler::attach());
+    EXPECT_FALSE(profiler::attach());
+
+    // Samples are taken by the CPU time of the thread and aggregated by the
+    // processing loop.
+    volatile std::uint64_t sum = 0;
+    const auto deadline = std::chrono::steady_clock::now() + 2s;
+    while ((profiler::samples() == 0) && (std::chrono::steady_clock::now() < deadline)) {
+        for (std::uint64_t i = 0; i < 1000000; ++i) {
+            sum = sum + i;
+        }
+        sm.signals_processing(0ms, true);
+    }
+    profiler::detach();
+
+    // Threads exiting without 'detach' release their slots.
+    for (std::size_t i = 0; i < profiler::max_threads + 1; ++i) {
+        bool is_attached = false;
+        std::thread([&is_attached]() -> void { is_attached = profiler::attach(); }).join();
+        EXPECT_TRUE(is_attached);
+    }
+    profiler::stop(sm);
+
+    EXPECT_TRUE(profiler::samples() > 0);
+    EXPECT_FALSE(profiler::folded().empty());
+    profiler::reset();
+    EXPECT_TRUE(profiler::samples() == 0);
+}
+
+#if defined(SIGNALS_MANAGER_USE_STATS)
+TEST(signals, stats)
+{
+    using namespace std::chrono_literals;
+    const int kSigRT = SIGRTMIN + 1;
+
+    wstux::signals::manager::options opts;
+    opts.delivery = wstux::signals::backend::sigaction;
+    opts.queue_capacity = 4;
+    wstux::signals::manager sm(opts);
+
+    EXPECT_TRUE(sm.set_handler(kSigRT, []() -> void { std::this_thread::sleep_for(1ms); }));
+    EXPECT_TRUE(sm.set_handler(SIGUSR1, [](wstux::signals::sig_num_t, std::size_t) -> void {}));
+    for (int i = 0; i < 5; ++i) {
+        ::sigqueue(::getpid(), kSigRT, ::sigval{i});
+    }
+    ::kill(::getpid(), SIGUSR1);
+    sm.signals_processing(100ms, true);
+
+    const wstux::signals::manager_stats stats = sm.stats();
+    EXPECT_TRUE(stats.max_queue_depth == 4);
+    EXPECT_TRUE(stats.signals.size() == 2);
+    for (const wstux::signals::signal_stats& sig_stats : stats.signals) {
+        if (sig_stats.sig == kSigRT) {
+            EXPECT_TRUE(sig_stats.handled == 4);
+            EXPECT_TRUE(sig_stats.dropped == 1);
+            EXPECT_TRUE(sig_stats.latency.count == 4);
+            EXPECT_TRUE(sig_stats.duration.count == 4);
+            EXPECT_TRUE(sig_stats.duration.percentile(0.5) >= 1000000);
+            EXPECT_TRUE(sig_stats.duration.max >= 1000000);
+        } else {
+            EXPECT_TRUE(sig_stats.sig == SIGUSR1);
+            EXPECT_TRUE(sig_stats.handled == 1);
+            EXPECT_TRUE(sig_stats.latency.count == 1);
+            EXPECT_TRUE(sig_stats.duration.count == 1);
+        }
+    }
+}
+#endif
+
+TEST(signals, static_manager)
+{
+    using namespace std::chrono_literals;
+
+    int usr1_count = 0;
+    int usr2_value = -1;
+    auto sm = wstux::signals::static_manager(
+        wstux::signals::make_handler<SIGUSR1>([&usr1_count]() -> void { ++usr1_count; }),
+        wstux::signals::make_handler<SIGUSR2>([&usr2_value](wstux::signals::sig_num_t, const wstux::signals::sig_info_t& info) -> void {
+            usr2_value = info.si_value.sival_int;
+        }));
+    static_assert(decltype(sm)::signals_mask == ((1 << (SIGUSR1 - 1)) | (1 << (SIGUSR2 - 1))), "Invalid signals mask");
+    EXPECT_TRUE(sm.is_installed());
+
+    ::kill(::getpid(), SIGUSR1);
+    ::sigqueue(::getpid(), SIGUSR2, ::sigval{42});
+    sm.signals_processing(100ms, true);
+    EXPECT_TRUE(usr1_count == 1);
+    EXPECT_TRUE(usr2_value == 42);
+
+    EXPECT_TRUE(sm.threaded_signals_processing());
+    std::this_thread::sleep_for(50ms);
+    ::kill(::getpid(), SIGUSR1);
+    for (int i = 0; (i < 100) && (usr1_count != 2); ++i) {
+        std::this_thread::sleep_for(10ms);
+    }
+    sm.stop_processing();
+    EXPECT_TRUE(usr1_count == 2);
+    EXPECT_TRUE(sm.dropped() == 0);
+}
+
+TEST(semaphore, timed_wait)
+{
+    using namespace std::chrono_literals;
+
+    wstux::signals::details::semaphore sem;
+    const std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    EXPECT_FALSE(sem.timed_wait(50ms));
+    EXPECT_TRUE(std::chrono::steady_clock::now() - begin >= 50ms);
+
+    sem.post();
+    EXPECT_TRUE(sem.timed_wait(50ms));
+    EXPECT_FALSE(sem.try_wait());
+}
+
+TEST(semaphore, post)
+{
+    using namespace std::chrono_literals;
+
+    wstux::signals::details::semaphore sem;
+    std::thread tr([&sem] {
+        std::this_thread::sleep_for(20ms);
+        sem.post();
+        sem.post();
+    });
+    sem.wait();
+    EXPECT_TRUE(sem.timed_wait(1s));
+    tr.join();
+    EXPECT_FALSE(sem.try_wait());
+}
+
+TEST(queue, bounded)
+{
+    wstux::signals::details::queue<int, 5> q;
+    EXPECT_FALSE(q.reset(1));
+    EXPECT_TRUE(q.empty());
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_TRUE(q.try_push(i));
+    }
+    EXPECT_FALSE(q.try_push(5));
+
+    int values[8] = {};
+    EXPECT_TRUE(q.pop_bulk(values, 3) == 3);
+    EXPECT_TRUE((values[0] == 0) && (values[1] == 1) && (values[2] == 2));
+    EXPECT_TRUE(q.try_push(5));
+    EXPECT_TRUE(q.try_push(6));
+    EXPECT_TRUE(q.pop_bulk(values, 8) == 4);
+    EXPECT_TRUE((values[0] == 3) && (values[1] == 4) && (values[2] == 5) && (values[3] == 6));
+    EXPECT_TRUE(q.empty());
+}
+
+TEST(queue, multi_producer)
+{
+    constexpr int kProducers = 4;
+    constexpr int kCount = 10000;
+
+    wstux::signals::details::queue<int, 64> q;
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&q, p]() -> void {
+            for (int i = 0; i < kCount; ++i) {
+                while (! q.try_push(p * kCount + i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    std::vector<int> last(kProducers, -1);
+    bool is_ordered = true;
+    int values[16];
+    for (int received = 0; received < kProducers * kCount;) {
+        const std::size_t count = q.pop_bulk(values, 16);
+        for (std::size_t i = 0; i < count; ++i) {
+            const int p = values[i] / kCount;
+            is_ordered = is_ordered && (values[i] % kCount == last[p] + 1);
+            last[p] = values[i] % kCount;
+        }
+        received += static_cast<int>(count);
+    }
+    for (std::thread& tr : producers) {
+        tr.join();
+    }
+    EXPECT_TRUE(is_ordered);
+    EXPECT_TRUE(q.empty());
+}
+
 int main(int /*argc*/, char** /*argv*/)
 {
     return RUN_ALL_TESTS();